@@ -0,0 +1,395 @@
+/*
+  Copyright (C) 2012 chiizu
+  chiizu.pprng@gmail.com
+  
+  This file is part of libpprng.
+  
+  libpprng is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  libpprng is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License
+  along with libpprng.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "AdjacentSeedGenerator.h"
+#include "SeedGenerator.h"
+#include "LinearCongruentialRNG.h"
+
+#include <list>
+#include <boost/thread.hpp>
+
+using namespace boost::posix_time;
+
+namespace pprng
+{
+
+namespace
+{
+
+// steps through the delays, then the seconds, of a window of time seeds
+class TimeDelayGenerator
+{
+public:
+  struct SeedType
+  {
+    ptime     time;
+    uint32_t  delay;
+  };
+  
+  typedef uint32_t  SeedCountType;
+  
+  TimeDelayGenerator(const ptime &fromTime, const ptime &toTime,
+                     uint32_t delayLow, uint32_t delayHigh, uint32_t delayStep)
+    : m_fromTime(fromTime), m_toTime(toTime),
+      m_delayLow(delayLow), m_delayHigh(delayHigh), m_delayStep(delayStep)
+  {
+    m_seed.time = fromTime - seconds(1);
+    m_seed.delay = delayHigh;
+  }
+  
+  SeedCountType NumberOfSeeds() const
+  {
+    SeedCountType  numSeconds = (m_toTime - m_fromTime).total_seconds() + 1;
+    SeedCountType  numDelays = ((m_delayHigh - m_delayLow) / m_delayStep) + 1;
+    
+    return numSeconds * numDelays;
+  }
+  
+  SeedType Next()
+  {
+    // checked before stepping, so a delay near the top cannot wrap around
+    if ((m_delayHigh - m_seed.delay) < m_delayStep)
+    {
+      m_seed.delay = m_delayLow;
+      m_seed.time = m_seed.time + seconds(1);
+    }
+    else
+    {
+      m_seed.delay += m_delayStep;
+    }
+    
+    return m_seed;
+  }
+  
+  // each part takes a run of the seconds
+  std::list<TimeDelayGenerator> Split(uint32_t parts) const
+  {
+    std::list<TimeDelayGenerator>  result;
+    
+    uint32_t  totalSeconds = (m_toTime - m_fromTime).total_seconds() + 1;
+    
+    if (parts > totalSeconds)
+      parts = totalSeconds;
+    
+    uint32_t  partSeconds = (totalSeconds + parts - 1) / parts;
+    ptime     fromTime = m_fromTime;
+    
+    while (fromTime <= m_toTime)
+    {
+      ptime  toTime = fromTime + seconds(partSeconds - 1);
+      if (toTime > m_toTime)
+        toTime = m_toTime;
+      
+      result.push_back(TimeDelayGenerator(fromTime, toTime, m_delayLow,
+                                          m_delayHigh, m_delayStep));
+      
+      fromTime = toTime + seconds(1);
+    }
+    
+    return result;
+  }
+  
+private:
+  ptime     m_fromTime, m_toTime;
+  uint32_t  m_delayLow, m_delayHigh, m_delayStep;
+  SeedType  m_seed;
+};
+
+
+template <class SeedGenerator, class ResultMaker>
+struct PartGenerator
+{
+  typedef typename ResultMaker::Results  Results;
+  
+  PartGenerator(const SeedGenerator &seedGenerator,
+                const ResultMaker &resultMaker, Results &results)
+    : m_seedGenerator(seedGenerator), m_resultMaker(resultMaker),
+      m_results(results)
+  {}
+  
+  void operator()()
+  {
+    typename SeedGenerator::SeedCountType  numSeeds =
+      m_seedGenerator.NumberOfSeeds();
+    
+    m_results.reserve(numSeeds);
+    
+    while (numSeeds-- > 0)
+      m_results.push_back(m_resultMaker(m_seedGenerator.Next()));
+  }
+  
+  SeedGenerator       m_seedGenerator;
+  const ResultMaker   &m_resultMaker;
+  Results             &m_results;
+};
+
+// each thread fills in the results for its own run of the seeds, which are
+// then joined back together in order
+template <class SeedGenerator, class ResultMaker>
+typename ResultMaker::Results GenerateResults(SeedGenerator &seedGenerator,
+                                              const ResultMaker &resultMaker)
+{
+  typedef typename ResultMaker::Results  Results;
+  
+  std::list<SeedGenerator>  generators =
+    seedGenerator.Split(boost::thread::hardware_concurrency());
+  
+  std::vector<Results>  partResults(generators.size());
+  boost::thread_group   threads;
+  
+  typename std::list<SeedGenerator>::const_iterator  sg = generators.begin();
+  for (uint32_t i = 0; sg != generators.end(); ++i, ++sg)
+  {
+    threads.create_thread(PartGenerator<SeedGenerator, ResultMaker>
+                            (*sg, resultMaker, partResults[i]));
+  }
+  
+  threads.join_all();
+  
+  Results  results;
+  
+  typename std::vector<Results>::const_iterator  pr;
+  for (pr = partResults.begin(); pr != partResults.end(); ++pr)
+    results.insert(results.end(), pr->begin(), pr->end());
+  
+  return results;
+}
+
+
+// timer0 and the time seed delay are both 16 bit values
+void GetVarianceRange(uint32_t target, uint32_t variance,
+                      uint32_t &low, uint32_t &high)
+{
+  if (target > 0xffff)
+    target = 0xffff;
+  
+  low = (target < variance) ? 0 : (target - variance);
+  high = (variance > (0xffff - target)) ? 0xffff : (target + variance);
+}
+
+template <class FrameGenerator>
+void AddIVs(FrameGenerator &generator,
+            const SearchCriteria::FrameRange &frameRange,
+            std::vector<IVs> &ivs)
+{
+  if (frameRange.max == 0)
+    return;
+  
+  uint32_t  firstFrame = (frameRange.min > 0) ? frameRange.min : 1;
+  
+  generator.SkipFrames(firstFrame - 1);
+  
+  for (uint32_t f = firstFrame; f <= frameRange.max; ++f)
+  {
+    generator.AdvanceFrame();
+    ivs.push_back(generator.CurrentFrame().ivs);
+  }
+}
+
+
+struct HashedResultMaker
+{
+  typedef HashedAdjacentSeedGenerator::Results  Results;
+  typedef HashedAdjacentSeedGenerator::Result   Result;
+  
+  HashedResultMaker(const HashedAdjacentSeedGenerator::Criteria &criteria)
+    : m_criteria(criteria)
+  {}
+  
+  Result operator()(const HashedSeed &seed) const
+  {
+    Result  result(seed);
+    
+    HashedIVFrameGenerator  ivGenerator(seed, m_criteria.ivFrameType);
+    AddIVs(ivGenerator, m_criteria.ivFrame, result.ivs);
+    
+    if (m_criteria.pidFrame.max > 0)
+    {
+      uint32_t  firstFrame =
+        (m_criteria.pidFrame.min > 0) ? m_criteria.pidFrame.min : 1;
+      
+      const Gen5PIDFrameGenerator::Parameters  &p =
+        m_criteria.pidFrameParameters;
+      
+      Gen5PIDFrameGenerator  pidGenerator(seed, p);
+      
+      // a generator starting from the lowest frame has already skipped them
+      result.skippedPIDFrames = p.startFromLowestFrame ?
+        pidGenerator.CurrentFrame().number :
+        seed.GetSkippedPIDFrames(p.memoryLinkUsed);
+      
+      pidGenerator.SkipFrames(firstFrame - 1);
+      
+      for (uint32_t f = firstFrame; f <= m_criteria.pidFrame.max; ++f)
+      {
+        pidGenerator.AdvanceFrame();
+        result.pidFrames.push_back(pidGenerator.CurrentFrame());
+      }
+    }
+    
+    return result;
+  }
+  
+  const HashedAdjacentSeedGenerator::Criteria  &m_criteria;
+};
+
+
+struct CGearResultMaker
+{
+  typedef CGearAdjacentSeedGenerator::Results  Results;
+  typedef CGearAdjacentSeedGenerator::Result   Result;
+  
+  CGearResultMaker(const CGearAdjacentSeedGenerator::Criteria &criteria)
+    : m_criteria(criteria)
+  {}
+  
+  Result operator()(const TimeDelayGenerator::SeedType &timeDelay) const
+  {
+    boost::gregorian::date  d = timeDelay.time.date();
+    time_duration           t = timeDelay.time.time_of_day();
+    
+    CGearSeed  seed(d.year(), d.month(), d.day(),
+                    t.hours(), t.minutes(), t.seconds(),
+                    timeDelay.delay, m_criteria.macAddressLow);
+    Result     result(seed, timeDelay.time, timeDelay.delay);
+    
+    CGearIVFrameGenerator  ivGenerator(seed.m_rawSeed, m_criteria.ivFrameType);
+    AddIVs(ivGenerator, m_criteria.ivFrame, result.ivs);
+    
+    return result;
+  }
+  
+  const CGearAdjacentSeedGenerator::Criteria  &m_criteria;
+};
+
+
+struct Gen4ResultMaker
+{
+  typedef Gen4AdjacentSeedGenerator::Results  Results;
+  typedef Gen4AdjacentSeedGenerator::Result   Result;
+  
+  Gen4ResultMaker(const Gen4AdjacentSeedGenerator::Criteria &criteria)
+    : m_criteria(criteria)
+  {}
+  
+  Result operator()(const TimeDelayGenerator::SeedType &timeDelay) const
+  {
+    boost::gregorian::date  d = timeDelay.time.date();
+    time_duration           t = timeDelay.time.time_of_day();
+    
+    TimeSeed  seed(d.year(), d.month(), d.day(),
+                   t.hours(), t.minutes(), t.seconds(), timeDelay.delay);
+    Result    result(seed, timeDelay.time, timeDelay.delay);
+    
+    result.coinFlips = CoinFlips(seed.m_seed, m_criteria.numCoinFlips);
+    result.roamers = HGSSRoamers(seed.m_seed, m_criteria.raikouLocation,
+                                 m_criteria.enteiLocation,
+                                 m_criteria.latiLocation);
+    
+    LCRNG34   rng(seed.m_seed);
+    uint32_t  skipped = result.roamers.ConsumedFrames();
+    
+    while (skipped-- > 0)
+      rng.Next();
+    
+    result.profElmResponses =
+      ProfElmResponses(rng.Seed(), m_criteria.numProfElmResponses);
+    
+    return result;
+  }
+  
+  const Gen4AdjacentSeedGenerator::Criteria  &m_criteria;
+};
+
+}
+
+
+HashedAdjacentSeedGenerator::Results
+  HashedAdjacentSeedGenerator::Generate(const Criteria &criteria)
+{
+  const HashedSeed::Parameters  &target = criteria.targetSeed;
+  HashedSeedGenerator::Parameters  p;
+  
+  p.version = target.version;
+  p.dsType = target.dsType;
+  p.macAddress = target.macAddress;
+  p.vcountLow = p.vcountHigh = target.vcount;
+  p.vframeLow = p.vframeHigh = target.vframe;
+  p.heldButtons.push_back(target.heldButtons);
+  
+  GetVarianceRange(target.timer0, criteria.timer0Variance,
+                   p.timer0Low, p.timer0High);
+  
+  ptime  targetTime(target.date, hours(target.hour) + minutes(target.minute) +
+                                 seconds(target.second));
+  
+  p.fromTime = targetTime - seconds(criteria.secondsVariance);
+  p.toTime = targetTime + seconds(criteria.secondsVariance);
+  
+  // each part's generator only hashes the message words that change
+  HashedSeedGenerator  seedGenerator(p);
+  
+  return GenerateResults(seedGenerator, HashedResultMaker(criteria));
+}
+
+
+CGearAdjacentSeedGenerator::Results
+  CGearAdjacentSeedGenerator::Generate(const Criteria &criteria)
+{
+  uint32_t  delayLow, delayHigh;
+  GetVarianceRange(criteria.targetDelay, criteria.delayVariance,
+                   delayLow, delayHigh);
+  
+  TimeDelayGenerator  seedGenerator
+    (criteria.targetTime - seconds(criteria.secondsVariance),
+     criteria.targetTime + seconds(criteria.secondsVariance),
+     delayLow, delayHigh, 1);
+  
+  return GenerateResults(seedGenerator, CGearResultMaker(criteria));
+}
+
+
+Gen4AdjacentSeedGenerator::Results
+  Gen4AdjacentSeedGenerator::Generate(const Criteria &criteria)
+{
+  uint32_t  delayLow, delayHigh;
+  GetVarianceRange(criteria.targetDelay, criteria.delayVariance,
+                   delayLow, delayHigh);
+  
+  uint32_t  delayStep = 1;
+  if (criteria.matchDelayParity)
+  {
+    delayStep = 2;
+    
+    if ((delayLow & 0x1) != (criteria.targetDelay & 0x1))
+      ++delayLow;
+  }
+  
+  TimeDelayGenerator  seedGenerator
+    (criteria.targetTime - seconds(criteria.secondsVariance),
+     criteria.targetTime + seconds(criteria.secondsVariance),
+     delayLow, delayHigh, delayStep);
+  
+  return GenerateResults(seedGenerator, Gen4ResultMaker(criteria));
+}
+
+}
@@ -0,0 +1,171 @@
+/*
+  Copyright (C) 2012 chiizu
+  chiizu.pprng@gmail.com
+  
+  This file is part of libpprng.
+  
+  libpprng is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  libpprng is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License
+  along with libpprng.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef ADJACENT_SEED_GENERATOR_H
+#define ADJACENT_SEED_GENERATOR_H
+
+#include "PPRNGTypes.h"
+#include "SearchCriteria.h"
+#include "HashedSeed.h"
+#include "CGearSeed.h"
+#include "TimeSeed.h"
+#include "FrameGenerator.h"
+
+#include <vector>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+namespace pprng
+{
+
+// Each of these generates the seeds around a target seed, varying its time
+// and its timer0 or delay, along with the frames an adjacents table shows for
+// every one of them.  The results are in time, then timer0 / delay order, and
+// the work is shared between all the available processors.
+
+class HashedAdjacentSeedGenerator
+{
+public:
+  struct Criteria
+  {
+    HashedSeed::Parameters             targetSeed;
+    uint32_t                           secondsVariance, timer0Variance;
+    
+    // IV frames to generate for each seed, none if ivFrame.max is 0
+    SearchCriteria::FrameRange         ivFrame;
+    HashedIVFrameGenerator::FrameType  ivFrameType;
+    
+    // PID frames to generate for each seed, none if pidFrame.max is 0;
+    // with pidFrameParameters.startFromLowestFrame set, these are counted
+    // from each seed's first usable frame
+    SearchCriteria::FrameRange         pidFrame;
+    Gen5PIDFrameGenerator::Parameters  pidFrameParameters;
+    
+    Criteria()
+      : targetSeed(), secondsVariance(0), timer0Variance(0),
+        ivFrame(), ivFrameType(HashedIVFrameGenerator::Normal),
+        pidFrame(), pidFrameParameters()
+    {}
+  };
+  
+  struct Result
+  {
+    Result(const HashedSeed &s)
+      : seed(s), ivs(), pidFrames(), skippedPIDFrames(0)
+    {}
+    
+    HashedSeed                 seed;
+    std::vector<IVs>           ivs;  // for frames ivFrame.min onwards
+    std::vector<Gen5PIDFrame>  pidFrames;
+    uint32_t                   skippedPIDFrames;  // set with pidFrames
+  };
+  
+  typedef std::vector<Result>  Results;
+  
+  static Results Generate(const Criteria &criteria);
+};
+
+
+class CGearAdjacentSeedGenerator
+{
+public:
+  struct Criteria
+  {
+    boost::posix_time::ptime          targetTime;
+    uint32_t                          targetDelay;
+    uint32_t                          macAddressLow;
+    uint32_t                          secondsVariance, delayVariance;
+    
+    // IV frames to generate for each seed, none if ivFrame.max is 0
+    SearchCriteria::FrameRange        ivFrame;
+    CGearIVFrameGenerator::FrameType  ivFrameType;
+    
+    Criteria()
+      : targetTime(), targetDelay(0), macAddressLow(0),
+        secondsVariance(0), delayVariance(0),
+        ivFrame(), ivFrameType(CGearIVFrameGenerator::Normal)
+    {}
+  };
+  
+  struct Result
+  {
+    Result(const CGearSeed &s, const boost::posix_time::ptime &t, uint32_t d)
+      : seed(s), time(t), delay(d), ivs()
+    {}
+    
+    CGearSeed                 seed;
+    boost::posix_time::ptime  time;
+    uint32_t                  delay;
+    std::vector<IVs>          ivs;  // for frames ivFrame.min onwards
+  };
+  
+  typedef std::vector<Result>  Results;
+  
+  static Results Generate(const Criteria &criteria);
+};
+
+
+class Gen4AdjacentSeedGenerator
+{
+public:
+  struct Criteria
+  {
+    boost::posix_time::ptime  targetTime;
+    uint32_t                  targetDelay;
+    uint32_t                  secondsVariance, delayVariance;
+    bool                      matchDelayParity;
+    
+    // HGSS roamer locations before the seed is hit
+    uint32_t                  raikouLocation, enteiLocation, latiLocation;
+    
+    uint32_t                  numCoinFlips, numProfElmResponses;
+    
+    Criteria()
+      : targetTime(), targetDelay(0), secondsVariance(0), delayVariance(0),
+        matchDelayParity(false),
+        raikouLocation(0), enteiLocation(0), latiLocation(0),
+        numCoinFlips(10), numProfElmResponses(10)
+    {}
+  };
+  
+  struct Result
+  {
+    Result(const TimeSeed &s, const boost::posix_time::ptime &t, uint32_t d)
+      : seed(s), time(t), delay(d), coinFlips(), profElmResponses(),
+        roamers()
+    {}
+    
+    TimeSeed                  seed;
+    boost::posix_time::ptime  time;
+    uint32_t                  delay;
+    CoinFlips                 coinFlips;
+    ProfElmResponses          profElmResponses;  // after the roamer frames
+    HGSSRoamers               roamers;
+  };
+  
+  typedef std::vector<Result>  Results;
+  
+  static Results Generate(const Criteria &criteria);
+};
+
+}
+
+#endif
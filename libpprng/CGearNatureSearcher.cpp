@@ -24,7 +24,7 @@
 #include "FrameGenerator.h"
 
 #include <list>
-#include <memory>
+#include <vector>
 
 namespace pprng
 {
@@ -52,10 +52,9 @@ public:
   enum { SeedsPerChunk = 1000 };
   
   NatureSeedGenerator(const CGearNatureSearcher::Criteria &criteria)
-    : m_timesList(ChooseTimes(criteria)), m_iter(m_timesList.begin()),
-      m_parameters(SetTimes(criteria.hashedSeedParameters, m_timesList)),
-      m_generator(new HashedSeedGenerator(m_parameters)),
-      m_numGeneratorSeeds(m_parameters.NumberOfSeeds()),
+    : m_timesList(ChooseTimes(criteria)), m_timeIndex(0),
+      m_generator(SetTimes(criteria.hashedSeedParameters, m_timesList)),
+      m_numGeneratorSeeds(m_generator.NumberOfSeeds()),
       m_seedNum(0)
   {}
   
@@ -68,14 +67,42 @@ public:
   {
     if (m_seedNum++ >= m_numGeneratorSeeds)
     {
-      ++m_iter;
-      m_parameters.fromTime = m_parameters.toTime = m_iter->natureTime;
-      m_generator.reset(new HashedSeedGenerator(m_parameters));
+      const boost::posix_time::ptime  &natureTime =
+        m_timesList[++m_timeIndex].natureTime;
+      
+      m_generator.SetTimeRange(natureTime, natureTime);
       
       m_seedNum = 1;
     }
     
-    return CGearNatureSeed(m_iter->cgearTime, m_generator->Next());
+    return CGearNatureSeed(m_timesList[m_timeIndex].cgearTime,
+                           m_generator.Next());
+  }
+  
+  // each part takes a run of the C-Gear times
+  std::list<NatureSeedGenerator> Split(uint32_t parts)
+  {
+    std::list<NatureSeedGenerator>  result;
+    
+    uint32_t  numTimes = m_timesList.size();
+    
+    if (parts > numTimes)
+      parts = numTimes;
+    
+    uint32_t  first = 0;
+    for (uint32_t i = 0; i < parts; ++i)
+    {
+      uint32_t  next = (uint64_t(numTimes) * (i + 1)) / parts;
+      
+      TimesList  partTimes(m_timesList.begin() + first,
+                           m_timesList.begin() + next);
+      
+      result.push_back(NatureSeedGenerator(partTimes, m_generator));
+      
+      first = next;
+    }
+    
+    return result;
   }
   
 private:
@@ -85,7 +112,16 @@ private:
     boost::posix_time::ptime  natureTime;
   };
   
-  typedef std::list<Times>  TimesList;
+  typedef std::vector<Times>  TimesList;
+  
+  NatureSeedGenerator(const TimesList &timesList,
+                      const HashedSeedGenerator &generator)
+    : m_timesList(timesList), m_timeIndex(0), m_generator(generator),
+      m_numGeneratorSeeds(generator.NumberOfSeeds()), m_seedNum(0)
+  {
+    m_generator.SetTimeRange(m_timesList.front().natureTime,
+                             m_timesList.front().natureTime);
+  }
   
   static TimesList ChooseTimes(const CGearNatureSearcher::Criteria &criteria)
   {
@@ -143,9 +179,8 @@ private:
   }
   
   const TimesList                           m_timesList;
-  TimesList::const_iterator                 m_iter;
-  HashedSeedGenerator::Parameters           m_parameters;
-  std::auto_ptr<HashedSeedGenerator>        m_generator;
+  TimesList::size_type                      m_timeIndex;
+  HashedSeedGenerator                       m_generator;
   const HashedSeedGenerator::SeedCountType  m_numGeneratorSeeds;
   HashedSeedGenerator::SeedCountType        m_seedNum;
 };
@@ -170,6 +205,17 @@ public:
     m_frame.clusterSize = 0;
   }
   
+  void Reseed(const CGearNatureSeed &cgearNatureSeed)
+  {
+    m_pidFrameGenerator.Reseed(cgearNatureSeed.natureSeed);
+    
+    m_frame.seed = cgearNatureSeed.natureSeed;
+    m_frame.cgearTime = cgearNatureSeed.cgearTime;
+    m_frame.number = 0;
+    m_frame.nature = Nature::NONE;
+    m_frame.clusterSize = 0;
+  }
+  
   void SkipFrames(uint32_t numFrames)
   {
     m_pidFrameGenerator.SkipFrames(numFrames);
@@ -246,10 +292,10 @@ struct FrameGeneratorFactory
       m_maxFrame(criteria.frameRange.max)
   {}
   
-  NatureFrameGenerator operator()(const CGearNatureSeed &seed) const
+  NatureFrameGenerator* operator()(const CGearNatureSeed &seed) const
   {
-    return NatureFrameGenerator(seed, m_pidParameters, m_pidCriteria,
-                                m_maxFrame);
+    return new NatureFrameGenerator(seed, m_pidParameters, m_pidCriteria,
+                                    m_maxFrame);
   }
   
   static Gen5PIDFrameGenerator::Parameters
@@ -302,8 +348,8 @@ void CGearNatureSearcher::Search
   
   SearchRunner              searcher;
   
-  searcher.Search(seedGenerator, seedSearcher, frameChecker,
-                  resultHandler, progressHandler);
+  searcher.SearchThreaded(seedGenerator, seedSearcher, frameChecker,
+                          resultHandler, progressHandler);
 }
 
 }
@@ -54,15 +54,16 @@ public:
       : seed(s), cgearTime(cgt)
     {}
     
-    const HashedSeed              seed;
-    const CGearSeed::TimeElement  cgearTime;
+    HashedSeed                    seed;
+    CGearSeed::TimeElement        cgearTime;
     uint32_t                      number;
     Nature::Type                  nature;
     uint32_t                      clusterSize;
   };
   
   typedef CGearNatureFrame                           ResultType;
-  typedef boost::function<void (const ResultType&)>  ResultCallback;
+  typedef boost::function<void (const ResultType*, std::size_t)>
+                                                     ResultCallback;
   
   CGearNatureSearcher() {}
   
@@ -30,41 +30,6 @@ namespace pprng
 namespace
 {
 
-class FastSearchSeedGenerator
-{
-public:
-  typedef uint32_t  SeedType;
-  typedef uint32_t  SeedCountType;
-  
-  enum { SeedsPerChunk = 1000 };
-  
-  FastSearchSeedGenerator()
-    : m_dayMonthMinuteSecond(0xff000000), m_hour(0x00170000)
-  {}
-  
-  SeedCountType NumberOfSeeds() const
-  {
-    return 256 * 24;
-  }
-  
-  SeedType Next()
-  {
-    m_hour += 0x00010000;
-    
-    if (m_hour > 0x00170000)
-    {
-      m_hour = 0x00000000;
-      m_dayMonthMinuteSecond += 0x01000000;
-    }
-    
-    return m_dayMonthMinuteSecond | m_hour;
-  }
-  
-private:
-  uint32_t  m_dayMonthMinuteSecond;
-  uint32_t  m_hour;
-};
-
 struct FrameChecker
 {
   FrameChecker(const CGearSeedSearcher::Criteria &criteria)
@@ -91,6 +56,9 @@ struct FrameChecker
   const CGearSeedSearcher::Criteria  &m_criteria;
 };
 
+// Base seeds arrive in ascending order within each thread's chunk of the
+// search, so rather than a binary search of the IV seed map for every base
+// seed, the map is walked forward alongside them as a linear merge.
 class FastSeedSearcher
 {
 public:
@@ -100,35 +68,59 @@ public:
                    const CGearSeedSearcher::Criteria &criteria)
     : m_seedMap(seedMap), m_frameRange(criteria.frameRange),
       m_minDelay(criteria.minDelay), m_maxDelay(criteria.maxDelay),
-      m_macAddressLow(criteria.macAddressLow)
+      m_macAddressLow(criteria.macAddressLow),
+      m_position(seedMap.end()), m_positionSeed(0), m_hasPosition(false)
   {}
   
+  template <class ResultCallback>
   void Search(uint32_t baseSeed, const FrameChecker &frameChecker,
-              const CGearSeedSearcher::ResultCallback &resultHandler)
+              const ResultCallback &resultHandler)
   {
     uint32_t  lowSeed = baseSeed + (m_minDelay & 0xFFFF) + m_macAddressLow;
     uint32_t  highSeed = baseSeed + (m_maxDelay & 0xFFFF) + m_macAddressLow;
     
+    AdvanceTo(lowSeed);
+    
     if (lowSeed <= highSeed)
     {
-      SearchUntil(m_seedMap.lower_bound(lowSeed),
-                  m_seedMap.upper_bound(highSeed), frameChecker, resultHandler);
+      SearchUntil(m_position, highSeed, frameChecker, resultHandler);
     }
     else
     {
-      SearchUntil(m_seedMap.lower_bound(lowSeed), m_seedMap.end(),
-                  frameChecker, resultHandler);
-      SearchUntil(m_seedMap.begin(), m_seedMap.upper_bound(highSeed),
-                  frameChecker, resultHandler);
+      SearchUntil(m_position, 0xFFFFFFFF, frameChecker, resultHandler);
+      SearchUntil(m_seedMap.begin(), highSeed, frameChecker, resultHandler);
     }
   }
   
 private:
-  void SearchUntil(IVSeedMap::const_iterator i, IVSeedMap::const_iterator end,
+  // moves to the first map entry not less than seed
+  void AdvanceTo(uint32_t seed)
+  {
+    if (!m_hasPosition || (seed < m_positionSeed))
+    {
+      // first seed of a chunk
+      m_position = m_seedMap.lower_bound(seed);
+      m_hasPosition = true;
+    }
+    else
+    {
+      IVSeedMap::const_iterator  end = m_seedMap.end();
+      
+      while ((m_position != end) && (m_position->first < seed))
+        ++m_position;
+    }
+    
+    m_positionSeed = seed;
+  }
+  
+  template <class ResultCallback>
+  void SearchUntil(IVSeedMap::const_iterator i, uint32_t highSeed,
                    const FrameChecker &frameChecker,
-                   const CGearSeedSearcher::ResultCallback &resultHandler)
+                   const ResultCallback &resultHandler)
   {
-    while (i != end)
+    IVSeedMap::const_iterator  end = m_seedMap.end();
+    
+    while ((i != end) && (i->first <= highSeed))
     {
       if ((i->second.frame >= (m_frameRange.min + 2)) &&
           (i->second.frame <= (m_frameRange.max + 2)))
@@ -150,6 +142,10 @@ private:
   const IVSeedMap                   &m_seedMap;
   const SearchCriteria::FrameRange  &m_frameRange;
   const uint32_t                    m_minDelay, m_maxDelay, m_macAddressLow;
+  
+  IVSeedMap::const_iterator         m_position;
+  uint32_t                          m_positionSeed;
+  bool                              m_hasPosition;
 };
 
 
@@ -161,9 +157,9 @@ struct FrameGeneratorFactory
     : m_frameType(frameType)
   {}
   
-  CGearIVFrameGenerator operator()(uint32_t seed) const
+  CGearIVFrameGenerator* operator()(uint32_t seed) const
   {
-    return CGearIVFrameGenerator(seed, m_frameType);
+    return new CGearIVFrameGenerator(seed, m_frameType);
   }
   
   const CGearIVFrameGenerator::FrameType m_frameType;
@@ -198,11 +194,11 @@ void CGearSeedSearcher::Search
   SearchRunner  searcher;
   
   IVPattern::Type  ivPattern = criteria.ivs.GetPattern();
+  uint32_t         maxFrame = IVSeedMapMaxFrameFor(criteria.ivs.isRoamer);
   
   if ((ivPattern == IVPattern::CUSTOM) ||
-      ((criteria.frameRange.min + 2) > IVSeedMapMaxFrame) ||
-      ((criteria.frameRange.max + 2) > IVSeedMapMaxFrame) ||
-      criteria.ivs.isRoamer)
+      ((criteria.frameRange.min + 2) > maxFrame) ||
+      ((criteria.frameRange.max + 2) > maxFrame))
   {
     CGearSeedGenerator     seedGenerator(criteria.minDelay,
                                          criteria.maxDelay,
@@ -215,16 +211,17 @@ void CGearSeedSearcher::Search
     SeedFrameSearcher<FrameGeneratorFactory>  seedSearcher(frameGenFactory,
                                                            criteria.frameRange);
     
-    searcher.Search(seedGenerator, seedSearcher, frameChecker,
-                    resultHandler, progressHandler);
+    searcher.SearchThreaded(seedGenerator, seedSearcher, frameChecker,
+                            resultHandler, progressHandler);
   }
   else
   {
-    FastSearchSeedGenerator  seedGenerator;
-    FastSeedSearcher         seedSearcher(GetIVSeedMap(ivPattern), criteria);
+    TimeSeedBaseGenerator    seedGenerator;
+    FastSeedSearcher         seedSearcher
+      (GetIVSeedMap(ivPattern, criteria.ivs.isRoamer), criteria);
     
-    searcher.Search(seedGenerator, seedSearcher, frameChecker,
-                    resultHandler, progressHandler);
+    searcher.SearchThreaded(seedGenerator, seedSearcher, frameChecker,
+                            resultHandler, progressHandler);
   }
 }
 
@@ -46,7 +46,8 @@ public:
   };
   
   typedef CGearIVFrameGenerator::Frame               ResultType;
-  typedef boost::function<void (const ResultType&)>  ResultCallback;
+  typedef boost::function<void (const ResultType*, std::size_t)>
+                                                     ResultCallback;
   
   CGearSeedSearcher() {}
   
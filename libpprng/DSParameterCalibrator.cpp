@@ -0,0 +1,182 @@
+/*
+  Copyright (C) 2012 chiizu
+  chiizu.pprng@gmail.com
+  
+  This file is part of libpprng.
+  
+  libpprng is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  libpprng is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License
+  along with libpprng.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "DSParameterCalibrator.h"
+#include "HashedSeedSearcher.h"
+#include "InitialSeedSearcher.h"
+#include "IncrementalSearch.h"
+
+#include <set>
+#include <map>
+#include <algorithm>
+#include <boost/ref.hpp>
+
+namespace pprng
+{
+
+HashedSeedGenerator::Parameters DSParameterCalibrator::Criteria::SeedParameters
+  (const Observation &observation) const
+{
+  HashedSeedGenerator::Parameters  p;
+  
+  p.version = version;
+  p.dsType = dsType;
+  p.macAddress = macAddress;
+  p.timer0Low = timer0Low;
+  p.timer0High = timer0High;
+  p.vcountLow = vcountLow;
+  p.vcountHigh = vcountHigh;
+  p.vframeLow = vframeLow;
+  p.vframeHigh = vframeHigh;
+  p.fromTime = observation.startTime;
+  p.toTime = observation.startTime;
+  p.heldButtons.push_back(observation.heldButtons);
+  
+  return p;
+}
+
+namespace
+{
+
+// vcount and vframe both fit in 16 bits on every DS
+uint64_t ParameterKey(uint32_t timer0, uint32_t vcount, uint32_t vframe)
+{
+  return (uint64_t(timer0) << 32) | (uint64_t(vcount) << 16) | vframe;
+}
+
+struct ParameterCollector
+{
+  ParameterCollector(std::set<uint64_t> &parameters)
+    : m_parameters(parameters)
+  {}
+  
+  void Add(const HashedSeed::Parameters &p) const
+  {
+    m_parameters.insert(ParameterKey(p.timer0, p.vcount, p.vframe));
+  }
+  
+  void operator()(const HashedIVFrame *frames, std::size_t numFrames) const
+  {
+    for (std::size_t i = 0; i < numFrames; ++i)
+      Add(frames[i].seed.parameters);
+  }
+  
+  void operator()(const HashedSeed *seeds, std::size_t numSeeds) const
+  {
+    for (std::size_t i = 0; i < numSeeds; ++i)
+      Add(seeds[i].parameters);
+  }
+  
+  std::set<uint64_t>  &m_parameters;
+};
+
+struct CalibrationResultSorter
+{
+  bool operator()(const DSParameterCalibrator::Result &a,
+                  const DSParameterCalibrator::Result &b) const
+  {
+    if (a.numObservations != b.numObservations)
+      return a.numObservations > b.numObservations;
+    
+    return ParameterKey(a.timer0, a.vcount, a.vframe) <
+           ParameterKey(b.timer0, b.vcount, b.vframe);
+  }
+};
+
+}
+
+DSParameterCalibrator::Results DSParameterCalibrator::Calibrate
+  (const Criteria &criteria,
+   const SearchRunner::ProgressCallback &progressHandler)
+{
+  typedef std::map<uint64_t, uint32_t>  CountMap;
+  
+  CountMap             counts;
+  PartProgressHandler  partProgressHandler(progressHandler);
+  
+  if (!criteria.observations.empty())
+    partProgressHandler.m_share = 1.0 / criteria.observations.size();
+  
+  ObservationList::const_iterator  o;
+  for (o = criteria.observations.begin();
+       (o != criteria.observations.end()) && !partProgressHandler.m_cancelled;
+       ++o)
+  {
+    std::set<uint64_t>  parameters;
+    ParameterCollector  collector(parameters);
+    
+    if (o->spins.NumSpins() > 0)
+    {
+      B2W2InitialSeedSearcher::Criteria  c;
+      
+      c.seedParameters = criteria.SeedParameters(*o);
+      c.memoryLinkUsed = o->memoryLinkUsed;
+      c.spins = o->spins;
+      
+      B2W2InitialSeedSearcher  searcher;
+      
+      searcher.Search(c, collector, boost::ref(partProgressHandler));
+    }
+    else
+    {
+      HashedSeedSearcher::Criteria  c;
+      
+      c.seedParameters = criteria.SeedParameters(*o);
+      c.ivs = o->ivs;
+      c.ivFrame = o->ivFrame;
+      
+      HashedSeedSearcher  searcher;
+      
+      searcher.Search(c, collector, boost::ref(partProgressHandler));
+    }
+    
+    std::set<uint64_t>::const_iterator  i;
+    for (i = parameters.begin(); i != parameters.end(); ++i)
+      ++counts[*i];
+  }
+  
+  Results  results;
+  
+  if (partProgressHandler.m_cancelled)
+    return results;
+  
+  results.reserve(counts.size());
+  
+  CountMap::const_iterator  i;
+  for (i = counts.begin(); i != counts.end(); ++i)
+  {
+    Result  r;
+    
+    r.timer0 = uint32_t(i->first >> 32);
+    r.vcount = uint32_t(i->first >> 16) & 0xffff;
+    r.vframe = uint32_t(i->first) & 0xffff;
+    r.numObservations = i->second;
+    
+    results.push_back(r);
+  }
+  
+  std::sort(results.begin(), results.end(), CalibrationResultSorter());
+  
+  return results;
+}
+
+}
@@ -0,0 +1,102 @@
+/*
+  Copyright (C) 2012 chiizu
+  chiizu.pprng@gmail.com
+  
+  This file is part of libpprng.
+  
+  libpprng is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  libpprng is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License
+  along with libpprng.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef DS_PARAMETER_CALIBRATOR_H
+#define DS_PARAMETER_CALIBRATOR_H
+
+#include "PPRNGTypes.h"
+#include "SearchCriteria.h"
+#include "SearchRunner.h"
+#include "SeedGenerator.h"
+
+#include <vector>
+
+namespace pprng
+{
+
+// Works out a DS's timer0, vcount and vframe from one or more observations
+// of a known start time.  Only the given parameter ranges are searched at
+// each observation's exact time, and the parameters found are intersected
+// across the observations.
+class DSParameterCalibrator
+{
+public:
+  struct Observation
+  {
+    boost::posix_time::ptime  startTime;
+    uint32_t                  heldButtons;
+    
+    // IVs of a Pokemon caught at one of the IV frames, used when no spins
+    // are given
+    SearchCriteria::IVCriteria  ivs;
+    SearchCriteria::FrameRange  ivFrame;
+    
+    // B2W2 spinner sequence seen at start up
+    bool                        memoryLinkUsed;
+    SpinnerPositions            spins;
+    
+    Observation()
+      : startTime(), heldButtons(0), ivs(), ivFrame(1, 1),
+        memoryLinkUsed(false), spins()
+    {}
+  };
+  
+  typedef std::vector<Observation>  ObservationList;
+  
+  struct Criteria
+  {
+    Game::Version    version;
+    DS::Type         dsType;
+    uint64_t         macAddress;
+    uint32_t         timer0Low, timer0High;
+    uint32_t         vcountLow, vcountHigh;
+    uint32_t         vframeLow, vframeHigh;
+    ObservationList  observations;
+    
+    Criteria()
+      : version(Game::Version(0)), dsType(DS::DSPhat), macAddress(0),
+        timer0Low(0), timer0High(0), vcountLow(0), vcountHigh(0),
+        vframeLow(0), vframeHigh(0), observations()
+    {}
+    
+    HashedSeedGenerator::Parameters
+      SeedParameters(const Observation &observation) const;
+  };
+  
+  struct Result
+  {
+    uint32_t  timer0, vcount, vframe;
+    uint32_t  numObservations;  // how many of the observations it explains
+  };
+  
+  // best first: most observations explained, then lowest timer0, vcount
+  // and vframe
+  typedef std::vector<Result>  Results;
+  
+  DSParameterCalibrator() {}
+  
+  Results Calibrate(const Criteria &criteria,
+                    const SearchRunner::ProgressCallback &progressHandler);
+};
+
+}
+
+#endif
@@ -76,8 +76,9 @@ struct SeedMapSearcher
                     ((criteria.frame.max - criteria.frame.min + 1) * 2))
   {}
   
+  template <class ResultCallback>
   void Search(const HashedSeed &seed, const FrameChecker &frameChecker,
-              const DreamRadarSeedSearcher::ResultCallback &resultHandler)
+              const ResultCallback &resultHandler)
   {
     uint32_t  ivSeed = seed.rawSeed >> 32;
     uint32_t  limit = m_lowIVFrame;
@@ -124,9 +125,9 @@ struct FrameGeneratorFactory
     : m_criteria(criteria)
   {}
   
-  DreamRadarFrameGenerator operator()(const HashedSeed &seed) const
+  DreamRadarFrameGenerator* operator()(const HashedSeed &seed) const
   {
-    return DreamRadarFrameGenerator(seed, m_criteria.frameParameters);
+    return new DreamRadarFrameGenerator(seed, m_criteria.frameParameters);
   }
   
   const DreamRadarSeedSearcher::Criteria  &m_criteria;
@@ -52,7 +52,8 @@ public:
   };
   
   typedef DreamRadarFrameGenerator::Frame            ResultType;
-  typedef boost::function<void (const ResultType&)>  ResultCallback;
+  typedef boost::function<void (const ResultType*, std::size_t)>
+                                                     ResultCallback;
   
   DreamRadarSeedSearcher() {}
   
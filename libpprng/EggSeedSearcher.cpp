@@ -21,11 +21,13 @@
 
 #include "EggSeedSearcher.h"
 #include "SeedSearcher.h"
+#include "IncrementalSearch.h"
 
 #include <stdexcept>
 #include <vector>
 #include <fstream>
 #include <string.h>
+#include <cstdio>
 
 #include <boost/shared_ptr.hpp>
 #include <boost/thread.hpp>
@@ -153,62 +155,175 @@ std::vector<IVRange> GenerateIVRanges(OptionalIVs parent1IVs,
 }
 
 
+// The ranges are compiled into a mask per stat and IV value of the ranges
+// allowing that value, so checking a frame is just six lookups and ANDs.
 struct IVFrameChecker
 {
   IVFrameChecker(const EggSeedSearcher::Criteria &criteria)
-    : m_possibleIVs(GenerateIVRanges(criteria.femaleIVs, criteria.maleIVs,
-                                     criteria.ivs.min, criteria.ivs.max))
-  {}
-  
-  bool operator()(const HashedIVFrame &frame) const
   {
-    std::vector<IVRange>::const_iterator  i;
-    for (i = m_possibleIVs.begin(); i != m_possibleIVs.end(); ++i)
+    std::vector<IVRange>  possibleIVs =
+      GenerateIVRanges(criteria.femaleIVs, criteria.maleIVs,
+                       criteria.ivs.min, criteria.ivs.max);
+    
+    std::memset(m_rangeMasks, 0, sizeof(m_rangeMasks));
+    
+    for (uint32_t r = 0; r < possibleIVs.size(); ++r)
     {
-      if (frame.ivs.betterThanOrEqual(i->minIVs) &&
-          frame.ivs.worseThanOrEqual(i->maxIVs))
+      const IVRange  &range = possibleIVs[r];
+      
+      for (uint32_t i = 0; i < 6; ++i)
       {
-        return true;
+        for (uint32_t iv = range.minIVs.iv(i); iv <= range.maxIVs.iv(i); ++iv)
+          m_rangeMasks[i][iv] |= 0x1 << r;
       }
     }
+  }
+  
+  bool operator()(const HashedIVFrame &frame) const
+  {
+    const IVs  &ivs = frame.ivs;
     
-    return false;
+    return (m_rangeMasks[IVs::HP][ivs.hp()] & m_rangeMasks[IVs::AT][ivs.at()] &
+            m_rangeMasks[IVs::DF][ivs.df()] & m_rangeMasks[IVs::SA][ivs.sa()] &
+            m_rangeMasks[IVs::SD][ivs.sd()] &
+            m_rangeMasks[IVs::SP][ivs.sp()]) != 0;
   }
   
-  const std::vector<IVRange>  m_possibleIVs;
+  uint32_t  m_rangeMasks[6][32];  // one bit per range, at most 6c3 = 20
 };
 
 
 
 
-struct IVFrameResultHandler
+// Checks a PID frame's nature, hidden ability, shininess, PID ability and
+// gender straight from the LCRNG values, consuming them exactly as
+// Gen5BreedingFrameGenerator::AdvanceFrame does.  Most frames fail on the
+// nature, so the inheritance and PID are only rolled for the rest.
+struct BreedingFrameFilter
+{
+  BreedingFrameFilter(const EggSeedSearcher::Criteria &criteria)
+    : m_criteria(criteria),
+      m_checkPID(criteria.shinyOnly ||
+                 (criteria.pid.ability != Ability::ANY) ||
+                 (criteria.pid.gender != Gender::ANY)),
+      m_checkFrame(m_checkPID || (criteria.pid.natureMask != 0) ||
+                   criteria.inheritsHiddenAbility)
+  {}
+  
+  bool operator()(uint64_t frameSeed) const
+  {
+    if (!m_checkFrame)
+      return true;
+    
+    const Gen5BreedingFrameGenerator::Parameters  &p =
+      m_criteria.frameParameters;
+    
+    LCRNG5  rng(frameSeed);
+    
+    // species
+    rng.Next();
+    
+    Nature::Type  nature = Nature::Type(((rng.Next() >> 32) * 25) >> 32);
+    bool          everstoneActivated =
+      p.usingEverstone && ((rng.Next() >> 63) == 1);
+    
+    if (!everstoneActivated && !m_criteria.pid.CheckNature(nature))
+      return false;
+    
+    bool  inheritsHiddenAbility = (((rng.Next() >> 32) * 5) >> 32) >= 2;
+    
+    if (m_criteria.inheritsHiddenAbility && !inheritsHiddenAbility)
+      return false;
+    
+    if (!m_checkPID)
+      return true;
+    
+    if (p.usingDitto)
+      rng.Next();
+    
+    uint32_t  inherited = 0, numInherited = 0;
+    while (numInherited < 3)
+    {
+      uint32_t  ivIndex = ((rng.Next() >> 32) * 6) >> 32;
+      rng.Next();
+      
+      if ((inherited & (0x1 << ivIndex)) == 0)
+      {
+        inherited |= 0x1 << ivIndex;
+        ++numInherited;
+      }
+    }
+    
+    PID  pid(Gen5PIDRNG::NextEggPIDWord(rng));
+    if (p.internationalParents)
+    {
+      uint32_t  shinyChecks = 0;
+      while (!pid.IsShiny(p.tid, p.sid) && (++shinyChecks < 6))
+        pid = Gen5PIDRNG::NextEggPIDWord(rng);
+    }
+    
+    return (!m_criteria.shinyOnly || pid.IsShiny(p.tid, p.sid)) &&
+           ((m_criteria.pid.ability == Ability::ANY) ||
+            (m_criteria.pid.ability == pid.Gen5Ability())) &&
+           Gender::GenderValueMatches(pid.GenderValue(),
+                                      m_criteria.pid.gender,
+                                      m_criteria.pid.genderRatio);
+  }
+  
+  const EggSeedSearcher::Criteria  &m_criteria;
+  const bool                       m_checkPID;
+  const bool                       m_checkFrame;
+};
+
+
+// the second stage, run in the worker threads for each IV frame found
+struct EggFrameStage
 {
-  IVFrameResultHandler(const EggSeedSearcher::Criteria &criteria,
-                       const EggSeedSearcher::ResultCallback &resultHandler)
-    : m_criteria(criteria), m_resultHandler(resultHandler)
+  typedef Gen5EggFrame  ResultType;
+  
+  EggFrameStage(const EggSeedSearcher::Criteria &criteria)
+    : m_criteria(criteria), m_frameFilter(criteria)
   {}
   
-  void operator()(const HashedIVFrame &frame) const
+  template <class ResultCallback>
+  void operator()(const HashedIVFrame &frame,
+                  const ResultCallback &resultHandler) const
   {
     Gen5BreedingFrameGenerator  generator
       (frame.seed, m_criteria.frameParameters);
     
-    uint32_t  frameNum = 0;
-    uint32_t  limitFrame = m_criteria.pid.startFromLowestFrame ?
-      frame.seed.GetSkippedPIDFrames(false) + 1 :
-      m_criteria.pidFrame.min - 1;
-    while (frameNum < limitFrame)
+    // each frame starts one LCRNG step after the last
+    LCRNG5    frameRNG(frame.seed.rawSeed);
+    uint32_t  frameNum;
+    
+    if (m_criteria.pid.startFromLowestFrame)
     {
-      generator.AdvanceFrame();
-      ++frameNum;
+      HashedSeed::SkippedPIDFrames  skippedFrames =
+        frame.seed.CalculateSkippedPIDFrames(false);
+      
+      frameRNG.Seed(skippedFrames.seed);
+      frameRNG.Next();
+      frameNum = skippedFrames.count + 1;
+    }
+    else
+    {
+      frameNum = m_criteria.pidFrame.min - 1;
+      frameRNG.AdvanceFrames(frameNum);
     }
     
     while (frameNum < m_criteria.pidFrame.max)
     {
-      generator.AdvanceFrame();
+      uint64_t  frameSeed = frameRNG.Seed();
+      frameRNG.Next();
       ++frameNum;
       
-      Gen5BreedingFrame  breedingFrame = generator.CurrentFrame();
+      if (!m_frameFilter(frameSeed))
+        continue;
+      
+      generator.SkipFrames(frameNum - 1 - generator.CurrentFrame().number);
+      generator.AdvanceFrame();
+      
+      const Gen5BreedingFrame  &breedingFrame = generator.CurrentFrame();
       
       if (CheckShiny(breedingFrame.pid) && CheckNature(breedingFrame) &&
           CheckAbility(breedingFrame) && CheckGender(breedingFrame) &&
@@ -220,7 +335,7 @@ struct IVFrameResultHandler
         
         if (CheckIVs(eggFrame.ivs) && CheckHiddenPower(eggFrame.ivs))
         {
-          m_resultHandler(eggFrame);
+          resultHandler(eggFrame);
         }
       }
     }
@@ -277,8 +392,8 @@ struct IVFrameResultHandler
                                             oivs.values.HiddenPower()));
   }
   
-  const EggSeedSearcher::Criteria        &m_criteria;
-  const EggSeedSearcher::ResultCallback  &m_resultHandler;
+  const EggSeedSearcher::Criteria  &m_criteria;
+  const BreedingFrameFilter        m_frameFilter;
 };
 
 
@@ -286,9 +401,9 @@ struct IVFrameGeneratorFactory
 {
   typedef HashedIVFrameGenerator  FrameGenerator;
   
-  HashedIVFrameGenerator operator()(const HashedSeed &seed) const
+  HashedIVFrameGenerator* operator()(const HashedSeed &seed) const
   {
-    return HashedIVFrameGenerator(seed, HashedIVFrameGenerator::Normal);
+    return new HashedIVFrameGenerator(seed, HashedIVFrameGenerator::Normal);
   }
 };
 
@@ -297,6 +412,10 @@ static std::string   s_CacheDirectory;
 static uint32_t      s_NumCacheReferences = 0;
 static boost::mutex  s_CacheMutex;
 
+// IV frames of the seed cache, counted as in Black / White
+static SearchCriteria::FrameRange  s_CacheFrames(8, 8);
+static SearchCriteria::FrameRange  s_LoadedCacheFrames;
+
 struct IVSeedSet
 {
   uint64_t  data[0x100000000ULL >> 6];
@@ -304,7 +423,7 @@ struct IVSeedSet
 
 static boost::shared_ptr<IVSeedSet>  s_IVSeedSet;
 
-static bool HasNamedCacheFile(const std::string &seedFile)
+static std::string CacheFilePath(const std::string &seedFile)
 {
   std::string  filePath = s_CacheDirectory;
   if (!filePath.empty())
@@ -313,24 +432,26 @@ static bool HasNamedCacheFile(const std::string &seedFile)
   }
   filePath += seedFile;
   
+  return filePath;
+}
+
+static bool HasNamedCacheFile(const std::string &seedFile)
+{
+  std::string  filePath = CacheFilePath(seedFile);
+  
   return !std::ifstream(filePath.c_str()).fail();
 }
 
+static const char      s_CacheFileHeader[] = "SEED_DELTA_FILE";
+static const uint32_t  s_CacheFileVersion = 0x0100;
+
 static
 EggSeedSearcher::CacheLoadResult
 LoadSeeds(const std::string &seedFile, boost::shared_ptr<IVSeedSet> &seedSetPtr)
 {
   using namespace  boost::interprocess;
   
-  std::string  filePath = s_CacheDirectory;
-  if (!filePath.empty())
-  {
-    filePath += '/';
-  }
-  filePath += seedFile;
-  
-  static const char  header[] = "SEED_DELTA_FILE";
-  const uint32_t     version = 0x0100;
+  std::string  filePath = CacheFilePath(seedFile);
   
   boost::shared_ptr<IVSeedSet>  result;
   
@@ -339,22 +460,23 @@ LoadSeeds(const std::string &seedFile, boost::shared_ptr<IVSeedSet> &seedSetPtr)
     file_mapping    fm(filePath.c_str(), read_only);
     mapped_region   mr(fm, read_only);
     
-    if (mr.get_size() < (sizeof(header) + sizeof(version) + sizeof(uint32_t)))
+    if (mr.get_size() < (sizeof(s_CacheFileHeader) +
+                         sizeof(s_CacheFileVersion) + sizeof(uint32_t)))
       return EggSeedSearcher::BAD_CACHE_FILE;
     
     const uint8_t  *buffer = static_cast<const uint8_t*>(mr.get_address());
     const uint8_t  *bufEnd = buffer + mr.get_size() - sizeof(uint32_t);
     
-    std::string  fileHeader((char*)buffer, sizeof(header) - 1);
-    if (fileHeader != header)
+    std::string  fileHeader((char*)buffer, sizeof(s_CacheFileHeader) - 1);
+    if (fileHeader != s_CacheFileHeader)
       return EggSeedSearcher::BAD_CACHE_FILE;
     
-    buffer += sizeof(header);
+    buffer += sizeof(s_CacheFileHeader);
     
     uint32_t  fileVersion;
     std::memcpy(&fileVersion, buffer, sizeof(uint32_t));
     
-    if (fileVersion != version)
+    if (fileVersion != s_CacheFileVersion)
       return EggSeedSearcher::BAD_CACHE_FILE;
     
     buffer += sizeof(uint32_t);
@@ -434,38 +556,195 @@ LoadSeeds(const std::string &seedFile, boost::shared_ptr<IVSeedSet> &seedSetPtr)
   return EggSeedSearcher::LOADED;
 }
 
+// only seeds in the cache need their IV frames generated
 struct SeedSearcher
 {
   typedef HashedIVFrame  ResultType;
   
-  SeedSearcher(const IVSeedSet &seedSet) : m_seedSet(seedSet) {}
+  SeedSearcher(const IVSeedSet &seedSet,
+               const IVFrameGeneratorFactory &frameGeneratorFactory,
+               const SearchCriteria::FrameRange &frameRange)
+    : m_seedSet(seedSet), m_frameSearcher(frameGeneratorFactory, frameRange)
+  {}
   
+  template <class ResultCallback>
   void Search(const HashedSeed &seed, const IVFrameChecker &frameChecker,
-              const boost::function<void (const ResultType&)> &resultHandler)
+              const ResultCallback &resultHandler)
   {
     uint32_t  ivSeed = seed.rawSeed >> 32;
     
     if (m_seedSet.data[ivSeed >> 6] & (0x1ULL << (ivSeed & 0x3f)))
+      m_frameSearcher.Search(seed, frameChecker, resultHandler);
+  }
+  
+  const IVSeedSet                             &m_seedSet;
+  SeedFrameSearcher<IVFrameGeneratorFactory>  m_frameSearcher;
+};
+
+bool LoadedSeedCacheCovers(const EggSeedSearcher::Criteria &criteria)
+{
+  uint32_t  offset =
+    EggSeedSearcher::CacheFrameOffset(criteria.seedParameters.version);
+  
+  return ((criteria.ivFrame.min + offset) >= s_LoadedCacheFrames.min) &&
+         ((criteria.ivFrame.max + offset) <= s_LoadedCacheFrames.max);
+}
+
+// An IV seed goes in the cache if any of its frames could be an egg's IVs
+// for one of the standard IV patterns, whatever the parents' IVs.  Three
+// IVs are inherited, so that needs the other three to fit the pattern.
+struct CachePattern
+{
+  IVs  minIVs, maxIVs;
+};
+
+static const CachePattern  s_CachePatterns[] =
+{
+  { IVs::Perfect, IVs::Perfect },
+  { IVs::PerfectTrick, IVs::PerfectTrick },
+  { IVs::PhysPerfect, IVs::Perfect },
+  { IVs::PhysPerfectTrick, IVs::PerfectTrick },
+  { IVs::SpecPerfect, IVs::Perfect },
+  { IVs::SpecPerfectTrick, IVs::PerfectTrick },
+  { IVs::HpPerfectLow, IVs::HpPerfectHigh },
+  { IVs::HpPerfectTrickLow, IVs::HpPerfectTrickHigh }
+};
+
+static const uint32_t  s_NumCachePatterns =
+  sizeof(s_CachePatterns) / sizeof(CachePattern);
+
+bool IsCacheIVFrame(IVs ivs)
+{
+  for (uint32_t i = 0; i < s_NumCachePatterns; ++i)
+  {
+    const CachePattern  &pattern = s_CachePatterns[i];
+    uint32_t            numFitting = 0;
+    
+    for (uint32_t j = 0; j < 6; ++j)
     {
-      HashedIVFrameGenerator  frameGen(seed, HashedIVFrameGenerator::Normal);
+      uint32_t  iv = ivs.iv(j);
       
-      frameGen.AdvanceFrame();
-      frameGen.AdvanceFrame();
-      frameGen.AdvanceFrame();
-      frameGen.AdvanceFrame();
-      frameGen.AdvanceFrame();
-      frameGen.AdvanceFrame();
-      frameGen.AdvanceFrame();
-      frameGen.AdvanceFrame();
+      if ((iv >= pattern.minIVs.iv(j)) && (iv <= pattern.maxIVs.iv(j)))
+        ++numFitting;
+    }
+    
+    if (numFitting >= 3)
+      return true;
+  }
+  
+  return false;
+}
+
+void WriteCacheDelta(std::ofstream &out, uint32_t delta)
+{
+  while (delta > 0x7f)
+  {
+    out.put(char((delta & 0x7f) | 0x80));
+    delta >>= 7;
+  }
+  
+  out.put(char(delta));
+}
+
+// Each seed of the cache generator is a block of 64 IV seeds, one word of
+// the seed set, so no two threads ever write the same word.
+class CacheBlockGenerator
+{
+public:
+  typedef uint32_t  SeedType;
+  typedef uint32_t  SeedCountType;
+  
+  enum { SeedsPerChunk = 0x100 };
+  enum { NumBlocks = 0x100000000ULL >> 6 };
+  
+  CacheBlockGenerator()
+    : m_block(0xffffffff), m_numBlocks(NumBlocks)
+  {}
+  
+  SeedCountType NumberOfSeeds() const { return m_numBlocks; }
+  
+  SeedType Next() { return ++m_block; }
+  
+  std::list<CacheBlockGenerator> Split(uint32_t parts)
+  {
+    std::list<CacheBlockGenerator>  result;
+    
+    uint32_t  first = 0;
+    for (uint32_t i = 0; i < parts; ++i)
+    {
+      uint32_t  next = (uint64_t(m_numBlocks) * (i + 1)) / parts;
+      
+      CacheBlockGenerator  part(*this);
+      part.m_block = m_block + first;
+      part.m_numBlocks = next - first;
       
-      HashedIVFrame  result = frameGen.CurrentFrame();
+      result.push_back(part);
       
-      if (frameChecker(result))
-        resultHandler(result);
+      first = next;
     }
+    
+    return result;
   }
   
-  const IVSeedSet  &m_seedSet;
+private:
+  uint32_t  m_block;
+  uint32_t  m_numBlocks;
+};
+
+// marks the block's IV seeds with a cache IV frame in the seed set
+struct CacheSeedSearcher
+{
+  typedef uint32_t  ResultType;
+  
+  CacheSeedSearcher(IVSeedSet &seedSet, uint32_t firstFrame,
+                    uint32_t lastFrame)
+    : m_seedSet(seedSet), m_firstFrame(firstFrame), m_lastFrame(lastFrame)
+  {}
+  
+  template <class ResultChecker, class ResultCallback>
+  void Search(uint32_t block, const ResultChecker&, const ResultCallback&)
+  {
+    MTRNG                      rng(block << 6);
+    Gen5BufferingIVRNG<MTRNG>  ivRNG(rng, Gen5BufferingIVRNG<MTRNG>::Normal);
+    
+    uint64_t  seedBits = 0;
+    
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+      rng.Seed((block << 6) | i);
+      ivRNG.Reset();
+      
+      if (HasCacheIVFrame(ivRNG))
+        seedBits |= 0x1ULL << i;
+    }
+    
+    m_seedSet.data[block] = seedBits;
+  }
+  
+  bool HasCacheIVFrame(Gen5BufferingIVRNG<MTRNG> &ivRNG) const
+  {
+    uint32_t  frame = 1;
+    for (/* empty */; frame < m_firstFrame; ++frame)
+      ivRNG.NextIVWord();
+    
+    for (/* empty */; frame <= m_lastFrame; ++frame)
+    {
+      if (IsCacheIVFrame(IVs(ivRNG.NextIVWord())))
+        return true;
+    }
+    
+    return false;
+  }
+  
+  IVSeedSet       &m_seedSet;
+  const uint32_t  m_firstFrame, m_lastFrame;
+};
+
+struct NoResultChecker {};
+
+struct NoResultHandler
+{
+  void operator()(const uint32_t*, std::size_t) {}
 };
 
 }
@@ -548,28 +827,34 @@ void EggSeedSearcher::Search
 {
   HashedSeedGenerator   seedGenerator(criteria.seedParameters);
   IVFrameChecker        ivFrameChecker(criteria);
-  IVFrameResultHandler  ivFrameResultHandler(criteria, resultHandler);
+  EggFrameStage         eggFrameStage(criteria);
+  IVFrameGeneratorFactory  ivFrameGenFactory;
   SearchRunner          searcher;
   
-  if ((criteria.ivs.GetPattern() == IVPattern::CUSTOM) ||
-      Game::IsBlack2White2(criteria.seedParameters.version) ||
-      (criteria.ivFrame.min != 8) || (criteria.ivFrame.max != 8) ||
-      (LoadSeedCache() != LOADED))
+  bool  useSeedCache = (criteria.ivs.GetPattern() != IVPattern::CUSTOM) &&
+                       (LoadSeedCache() == LOADED);
+  
+  if (useSeedCache && !LoadedSeedCacheCovers(criteria))
+  {
+    ReleaseSeedCache();
+    useSeedCache = false;
+  }
+  
+  if (!useSeedCache)
   {
-    IVFrameGeneratorFactory   ivFrameGenFactory;
-    
     SeedFrameSearcher<IVFrameGeneratorFactory>  seedSearcher(ivFrameGenFactory,
                                                              criteria.ivFrame);
     
     searcher.SearchThreaded(seedGenerator, seedSearcher, ivFrameChecker,
-                           ivFrameResultHandler, progressHandler);
+                            eggFrameStage, resultHandler, progressHandler);
   }
   else
   {
-    SeedSearcher          seedSearcher(*s_IVSeedSet);
+    SeedSearcher          seedSearcher(*s_IVSeedSet, ivFrameGenFactory,
+                                       criteria.ivFrame);
     
     searcher.SearchThreaded(seedGenerator, seedSearcher, ivFrameChecker,
-                            ivFrameResultHandler, progressHandler);
+                            eggFrameStage, resultHandler, progressHandler);
     ReleaseSeedCache();
   }
 }
@@ -579,9 +864,35 @@ void EggSeedSearcher::SetCacheDirectory(const std::string &dir)
   s_CacheDirectory = dir;
 }
 
+void EggSeedSearcher::SetCacheFrames(uint32_t firstFrame, uint32_t lastFrame)
+{
+  boost::unique_lock<boost::mutex>  lock(s_CacheMutex);
+  
+  s_CacheFrames = SearchCriteria::FrameRange(firstFrame, lastFrame);
+}
+
+// Black 2 / White 2 skip the first 2 IV frames
+uint32_t EggSeedSearcher::CacheFrameOffset(Game::Version version)
+{
+  return Game::IsBlack2White2(version) ? 2 : 0;
+}
+
+std::string EggSeedSearcher::CacheFileName(uint32_t firstFrame,
+                                           uint32_t lastFrame)
+{
+  if ((firstFrame == 8) && (lastFrame == 8))
+    return "eggseeds.dat";
+  
+  return "eggseeds_" + boost::lexical_cast<std::string>(firstFrame) + '-' +
+         boost::lexical_cast<std::string>(lastFrame) + ".dat";
+}
+
 bool EggSeedSearcher::HasCacheFile()
 {
-  return HasNamedCacheFile("eggseeds.dat");
+  boost::unique_lock<boost::mutex>  lock(s_CacheMutex);
+  
+  return HasNamedCacheFile(CacheFileName(s_CacheFrames.min,
+                                         s_CacheFrames.max));
 }
 
 EggSeedSearcher::CacheLoadResult EggSeedSearcher::LoadSeedCache()
@@ -592,9 +903,12 @@ EggSeedSearcher::CacheLoadResult EggSeedSearcher::LoadSeedCache()
   
   if (s_NumCacheReferences == 0)
   {
-    result = LoadSeeds("eggseeds.dat", s_IVSeedSet);
+    result = LoadSeeds(CacheFileName(s_CacheFrames.min, s_CacheFrames.max),
+                       s_IVSeedSet);
     if (result != LOADED)
       return result;
+    
+    s_LoadedCacheFrames = s_CacheFrames;
   }
   
   ++s_NumCacheReferences;
@@ -612,6 +926,77 @@ void EggSeedSearcher::ReleaseSeedCache()
   }
 }
 
+bool EggSeedSearcher::WriteSeedCache
+  (uint32_t firstFrame, uint32_t lastFrame,
+   const SearchRunner::ProgressCallback &progressHandler)
+{
+  std::string  filePath =
+    CacheFilePath(CacheFileName(firstFrame, lastFrame));
+  
+  // a search may be reading filePath, so it is only ever renamed over
+  std::string  tempFilePath = filePath + ".tmp";
+  
+  boost::shared_ptr<IVSeedSet>  seedSet;
+  PartProgressHandler           cacheProgressHandler(progressHandler);
+  
+  try
+  {
+    seedSet.reset(new IVSeedSet);
+    
+    CacheBlockGenerator  seedGenerator;
+    CacheSeedSearcher    seedSearcher(*seedSet, firstFrame, lastFrame);
+    NoResultChecker      resultChecker;
+    NoResultHandler      resultHandler;
+    SearchRunner         searcher;
+    
+    searcher.SearchThreaded(seedGenerator, seedSearcher, resultChecker,
+                            resultHandler, cacheProgressHandler);
+  }
+  catch (...)
+  {
+    return false;
+  }
+  
+  if (cacheProgressHandler.m_cancelled)
+    return false;
+  
+  std::ofstream  out(tempFilePath.c_str(), std::ios::out | std::ios::binary);
+  
+  out.write(s_CacheFileHeader, sizeof(s_CacheFileHeader));
+  out.write(reinterpret_cast<const char*>(&s_CacheFileVersion),
+            sizeof(s_CacheFileVersion));
+  
+  uint32_t  lastSeed = 0, seedCount = 0;
+  
+  for (uint32_t block = 0; block < CacheBlockGenerator::NumBlocks; ++block)
+  {
+    uint64_t  seedBits = seedSet->data[block];
+    
+    for (uint32_t i = 0; seedBits != 0; ++i, seedBits >>= 1)
+    {
+      if (seedBits & 0x1)
+      {
+        uint32_t  seed = (block << 6) | i;
+        
+        WriteCacheDelta(out, seed - lastSeed);
+        lastSeed = seed;
+        ++seedCount;
+      }
+    }
+  }
+  
+  out.write(reinterpret_cast<const char*>(&seedCount), sizeof(seedCount));
+  out.close();
+  
+  if (!out || (std::rename(tempFilePath.c_str(), filePath.c_str()) != 0))
+  {
+    std::remove(tempFilePath.c_str());
+    return false;
+  }
+  
+  return true;
+}
+
 void EggSeedSearcher::EnsureSeedCacheReleased()
 {
   do
@@ -63,7 +63,8 @@ public:
   };
   
   typedef Gen5EggFrame                               ResultType;
-  typedef boost::function<void (const ResultType&)>  ResultCallback;
+  typedef boost::function<void (const ResultType*, std::size_t)>
+                                                     ResultCallback;
   
   EggSeedSearcher() {}
   
@@ -73,6 +74,14 @@ public:
   // if not running from the command line, working directory may not be set
   static void SetCacheDirectory(const std::string &dir);
   
+  // The seed cache marks the IV seeds with a possible egg IV frame for one of
+  // the standard IV patterns, anywhere within a range of IV frames.  Frames
+  // are counted as in Black / White, so Black 2 / White 2 frame n is cache
+  // frame n + 2.  The default is frame 8 alone, from eggseeds.dat.
+  static void SetCacheFrames(uint32_t firstFrame, uint32_t lastFrame);
+  static uint32_t CacheFrameOffset(Game::Version version);
+  static std::string CacheFileName(uint32_t firstFrame, uint32_t lastFrame);
+  
   static bool HasCacheFile();
   
   enum CacheLoadResult
@@ -85,6 +94,12 @@ public:
   };
   static CacheLoadResult LoadSeedCache();
   static void ReleaseSeedCache();
+  
+  // generates the cache file for a range of frames, on every core, which can
+  // still take hours
+  static bool WriteSeedCache(uint32_t firstFrame, uint32_t lastFrame,
+                             const SearchRunner::ProgressCallback
+                               &progressHandler);
   static void EnsureSeedCacheReleased();
 };
 
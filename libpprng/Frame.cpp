@@ -30,43 +30,58 @@ namespace pprng
 namespace
 {
 
-template <class Method>
+template <bool RecordFrames>
+static void UpdateESV(ESV::Value value, uint32_t &esvMask,
+                      uint32_t frameNumber,
+                      Gen4Frame::EncounterData::FrameType frameType,
+                      Gen4Frame::EncounterData &encData)
+{
+  uint32_t  slot = ESV::Slot(value);
+  
+  esvMask |= 0x1 << slot;
+  
+  if (RecordFrames)
+    encData.esvFrames[ESV::SlotType(value) >> 8][slot].number[frameType] =
+      frameNumber;
+}
+
+template <class Method, bool RecordFrames>
 static void UpdateESVs(uint32_t percentage1, uint32_t percentage2,
                        uint32_t percentage3, uint32_t frameNumber,
                        Gen4Frame::EncounterData::FrameType frameType,
                        Gen4Frame::EncounterData &encData)
 {
-  ESV::Value  value = ESV::Gen4Land(percentage1);
-  encData.landESVs |= 0x1 << ESV::Slot(value);
-  encData.esvFrames[value].number[frameType] = frameNumber;
+  UpdateESV<RecordFrames>(ESV::Gen4Land(percentage1),
+                          encData.landESVs, frameNumber, frameType,
+                          encData);
   
-  value = ESV::Gen4Surfing(percentage2);
-  encData.surfESVs |= 0x1 << ESV::Slot(value);
-  encData.esvFrames[value].number[frameType] = frameNumber;
+  UpdateESV<RecordFrames>(ESV::Gen4Surfing(percentage2),
+                          encData.surfESVs, frameNumber, frameType,
+                          encData);
   
   if (percentage3 < Method::OldRodThreshold)
   {
-    value = Method::OldRodESV(percentage2);
-    encData.oldRodESVs |= ESV::Slot(value);
-    encData.esvFrames[value].number[frameType] = frameNumber;
+    UpdateESV<RecordFrames>(Method::OldRodESV(percentage2),
+                            encData.oldRodESVs, frameNumber,
+                            frameType, encData);
   }
   
   if (percentage3 < Method::GoodRodThreshold)
   {
-    value = Method::GoodRodESV(percentage2);
-    encData.goodRodESVs |= ESV::Slot(value);
-    encData.esvFrames[value].number[frameType] = frameNumber;
+    UpdateESV<RecordFrames>(Method::GoodRodESV(percentage2),
+                            encData.goodRodESVs, frameNumber,
+                            frameType, encData);
   }
   
   if (percentage3 < Method::SuperRodThreshold)
   {
-    value = Method::SuperRodESV(percentage2);
-    encData.superRodESVs |= ESV::Slot(value);
-    encData.esvFrames[value].number[frameType] = frameNumber;
+    UpdateESV<RecordFrames>(Method::SuperRodESV(percentage2),
+                            encData.superRodESVs, frameNumber,
+                            frameType, encData);
   }
 }
 
-template <class Method>
+template <class Method, bool RecordFrames>
 static void UpdateEncounterData(Gen4Frame::EncounterData &encData,
                                 Nature::Type nature,  uint32_t frameNumber,
                                 uint32_t randomValue1, uint32_t randomValue2,
@@ -81,9 +96,10 @@ static void UpdateEncounterData(Gen4Frame::EncounterData &encData,
     uint32_t  percentage3 = Method::CalculatePercentage(randomValue3);
     uint32_t  percentage4 = Method::CalculatePercentage(randomValue4);
     
-    UpdateESVs<Method>(percentage2, percentage3, percentage4,
-                       frameNumber, Gen4Frame::EncounterData::NoSync,
-                       encData);
+    UpdateESVs<Method, RecordFrames>(percentage2, percentage3, percentage4,
+                                     frameNumber,
+                                     Gen4Frame::EncounterData::NoSync,
+                                     encData);
     
     // check failed synchronize
     if (!Method::DetermineSync(randomValue2))
@@ -92,17 +108,20 @@ static void UpdateEncounterData(Gen4Frame::EncounterData &encData,
         frameNumber - 1;
       uint32_t  percentage5 = Method::CalculatePercentage(randomValue5);
       
-      UpdateESVs<Method>(percentage3, percentage4, percentage5,
-                         frameNumber - 1, Gen4Frame::EncounterData::FailedSync,
-                         encData);
+      UpdateESVs<Method, RecordFrames>(percentage3, percentage4, percentage5,
+                                       frameNumber - 1,
+                                       Gen4Frame::EncounterData::FailedSync,
+                                       encData);
     }
     
     // avoid percentage recalc by checking synchronize here
     if (Method::DetermineSync(randomValue1))
     {
       encData.lowestFrames.number[Gen4Frame::EncounterData::Sync] = frameNumber;
-      UpdateESVs<Method>(percentage2, percentage3, percentage4,
-                         frameNumber, Gen4Frame::EncounterData::Sync, encData);
+      UpdateESVs<Method, RecordFrames>(percentage2, percentage3, percentage4,
+                                       frameNumber,
+                                       Gen4Frame::EncounterData::Sync,
+                                       encData);
     }
   }
   // check Method synchronize
@@ -113,21 +132,19 @@ static void UpdateEncounterData(Gen4Frame::EncounterData &encData,
     uint32_t  percentage3 = Method::CalculatePercentage(randomValue3);
     uint32_t  percentage4 = Method::CalculatePercentage(randomValue4);
     
-    UpdateESVs<Method>(percentage2, percentage3, percentage4,
-                       frameNumber, Gen4Frame::EncounterData::Sync, encData);
+    UpdateESVs<Method, RecordFrames>(percentage2, percentage3, percentage4,
+                                     frameNumber,
+                                     Gen4Frame::EncounterData::Sync, encData);
   }
 }
 
-}
-
-Gen4Frame::Gen4Frame(const Gen34Frame &baseFrame)
-  : seed(baseFrame.seed), number(baseFrame.number),
-    rngValue(baseFrame.rngValue), pid(baseFrame.pid), ivs(baseFrame.ivs),
-    methodJ(), methodK()
+template <class Method, bool RecordFrames>
+static void CalculateEncounterData(const Gen4Frame &frame,
+                                   Gen4Frame::EncounterData &encData)
 {
-  Nature::Type  nature = baseFrame.pid.Gen34Nature();
-  LCRNG34_R     rng(baseFrame.rngValue);
-  int32_t       candidateFrameNumber = baseFrame.number - 1;
+  Nature::Type  nature = frame.pid.Gen34Nature();
+  LCRNG34_R     rng(frame.rngValue);
+  int32_t       candidateFrameNumber = frame.number - 1;
   uint32_t      randomValue3 = rng.Next();
   uint32_t      randomValue4 = rng.Next();
   uint32_t      randomValue5 = rng.Next();
@@ -141,13 +158,9 @@ Gen4Frame::Gen4Frame(const Gen34Frame &baseFrame)
     randomValue4 = rng.Next();
     randomValue5 = rng.Next();
     
-    UpdateEncounterData<MethodJ>(methodJ, nature, candidateFrameNumber,
-                                 randomValue1, randomValue2, randomValue3,
-                                 randomValue4, randomValue5);
-    
-    UpdateEncounterData<MethodK>(methodK, nature, candidateFrameNumber,
-                                 randomValue1, randomValue2, randomValue3,
-                                 randomValue4, randomValue5);
+    UpdateEncounterData<Method, RecordFrames>
+      (encData, nature, candidateFrameNumber,
+       randomValue1, randomValue2, randomValue3, randomValue4, randomValue5);
     
     PID  randomPID((randomValue1 & 0xffff0000) | (randomValue2 >> 16));
     
@@ -160,6 +173,59 @@ Gen4Frame::Gen4Frame(const Gen34Frame &baseFrame)
   }
 }
 
+}
+
+Gen4Frame::Gen4Frame(const Gen34Frame &baseFrame)
+  : seed(baseFrame.seed), number(baseFrame.number),
+    rngValue(baseFrame.rngValue), pid(baseFrame.pid), ivs(baseFrame.ivs),
+    m_methodJ(), m_methodK(),
+    m_methodJState(NotCalculated), m_methodKState(NotCalculated)
+{}
+
+const Gen4Frame::EncounterData& Gen4Frame::GetMethodJESVs() const
+{
+  if (m_methodJState == NotCalculated)
+  {
+    CalculateEncounterData<MethodJ, false>(*this, m_methodJ);
+    m_methodJState = ESVsCalculated;
+  }
+  
+  return m_methodJ;
+}
+
+const Gen4Frame::EncounterData& Gen4Frame::GetMethodKESVs() const
+{
+  if (m_methodKState == NotCalculated)
+  {
+    CalculateEncounterData<MethodK, false>(*this, m_methodK);
+    m_methodKState = ESVsCalculated;
+  }
+  
+  return m_methodK;
+}
+
+const Gen4Frame::EncounterData& Gen4Frame::GetMethodJData() const
+{
+  if (m_methodJState != DataCalculated)
+  {
+    CalculateEncounterData<MethodJ, true>(*this, m_methodJ);
+    m_methodJState = DataCalculated;
+  }
+  
+  return m_methodJ;
+}
+
+const Gen4Frame::EncounterData& Gen4Frame::GetMethodKData() const
+{
+  if (m_methodKState != DataCalculated)
+  {
+    CalculateEncounterData<MethodK, true>(*this, m_methodK);
+    m_methodKState = DataCalculated;
+  }
+  
+  return m_methodK;
+}
+
 
 namespace
 {
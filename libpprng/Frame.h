@@ -52,7 +52,7 @@ struct Gen4Frame
   {
     EncounterData()
       : lowestFrames(), landESVs(0), surfESVs(0),
-        oldRodESVs(0), goodRodESVs(0), superRodESVs(0), esvFrames()
+        oldRodESVs(0), goodRodESVs(0), superRodESVs(0)
     {}
     
     enum FrameType
@@ -65,6 +65,29 @@ struct Gen4Frame
       uint32_t  number[NumFrameTypes];
     };
     
+    // land, surf, old rod, good rod, super rod; up to 12 slots each
+    enum { NumESVTypes = 5, NumESVSlots = 12 };
+    
+    uint32_t ESVMask(ESV::Type type) const
+    {
+      switch (type)
+      {
+      case ESV::LAND_TYPE: return landESVs;
+      case ESV::SURF_TYPE: return surfESVs;
+      case ESV::OLD_ROD_TYPE: return oldRodESVs;
+      case ESV::GOOD_ROD_TYPE: return goodRodESVs;
+      case ESV::SUPER_ROD_TYPE: return superRodESVs;
+      default: return 0;
+      }
+    }
+    
+    bool HasESV(ESV::Value esv) const
+    { return (ESVMask(ESV::SlotType(esv)) & (0x1 << ESV::Slot(esv))) != 0; }
+    
+    // only filled in by Gen4Frame::GetMethodJData / GetMethodKData
+    const Frames& ESVFrames(ESV::Value esv) const
+    { return esvFrames[ESV::SlotType(esv) >> 8][ESV::Slot(esv)]; }
+    
     Frames    lowestFrames;
     uint32_t  landESVs;
     uint32_t  surfESVs;
@@ -72,11 +95,25 @@ struct Gen4Frame
     uint32_t  goodRodESVs;
     uint32_t  superRodESVs;
     
-    std::map<ESV::Value, Frames>  esvFrames;
+    Frames    esvFrames[NumESVTypes][NumESVSlots];
   };
   
-  EncounterData  methodJ;
-  EncounterData  methodK;
+  // Encounter data is calculated lazily, one method at a time.
+  // The ESV masks and lowest frames are available without filling in the
+  // per-ESV frame table.
+  const EncounterData& GetMethodJESVs() const;
+  const EncounterData& GetMethodKESVs() const;
+  
+  const EncounterData& GetMethodJData() const;
+  const EncounterData& GetMethodKData() const;
+  
+private:
+  enum CalculationState { NotCalculated, ESVsCalculated, DataCalculated };
+  
+  mutable EncounterData     m_methodJ;
+  mutable EncounterData     m_methodK;
+  mutable CalculationState  m_methodJState;
+  mutable CalculationState  m_methodKState;
 };
 
 struct Gen4EncounterFrame
@@ -149,7 +186,7 @@ struct Gen5PIDFrame
 {
   Gen5PIDFrame(const HashedSeed &s) : seed(s) {}
   
-  const HashedSeed        seed;
+  HashedSeed              seed;
   uint32_t                number;
   uint64_t                rngValue;
   bool                    isEncounter;
@@ -173,7 +210,7 @@ struct HashedIVFrame
 {
   HashedIVFrame(const HashedSeed &s) : seed(s) {}
   
-  const HashedSeed  seed;
+  HashedSeed        seed;
   uint32_t          number;
   IVs               ivs;
 };
@@ -182,7 +219,7 @@ struct WonderCardFrame
 {
   WonderCardFrame(const HashedSeed &s) : seed(s) {}
   
-  const HashedSeed  seed;
+  HashedSeed        seed;
   uint32_t          number;
   uint64_t          rngValue;
   PID               pid;
@@ -195,7 +232,7 @@ struct Gen5TrainerIDFrame
 {
   Gen5TrainerIDFrame(const HashedSeed &s) : seed(s) {}
   
-  const HashedSeed  seed;
+  HashedSeed        seed;
   uint32_t          number;
   uint32_t          tid, sid;
   bool              wildShiny, giftShiny, eggShiny;
@@ -209,7 +246,7 @@ struct Gen5BreedingFrame
     ResetInheritance();
   }
   
-  const HashedSeed  seed;
+  HashedSeed        seed;
   uint32_t          number;
   uint64_t          rngValue;
   bool              everstoneActivated;
@@ -250,7 +287,7 @@ struct DreamRadarFrame
 {
   DreamRadarFrame(const HashedSeed &s) : seed(s) {}
   
-  const HashedSeed  seed;
+  HashedSeed        seed;
   uint32_t          number;
   uint64_t          rngValue;
   PID               pid;
@@ -262,7 +299,7 @@ struct HiddenHollowSpawnFrame
 {
   HiddenHollowSpawnFrame(const HashedSeed &s) : seed(s) {}
   
-  const HashedSeed  seed;
+  HashedSeed        seed;
   uint32_t          number;
   uint64_t          rngValue;
   bool              isSpawn;
@@ -37,12 +37,26 @@ const IVs::Type  Gen4BreedingFrameGenerator::DPPtRound3[4] =
 
 CGearIVFrameGenerator::CGearIVFrameGenerator(uint32_t seed, FrameType frameType,
                                              bool skipFirstTwoFrames)
-  : m_RNG(seed), m_IVRNG(m_RNG, IVRNG::FrameType(frameType))
+  : m_RNG(seed), m_IVRNG(m_RNG, IVRNG::FrameType(frameType)),
+    m_skipFirstTwoFrames(skipFirstTwoFrames)
+{
+  Start(seed);
+}
+
+void CGearIVFrameGenerator::Reseed(uint32_t seed)
+{
+  m_RNG.Seed(seed);
+  m_IVRNG.Reset();
+  
+  Start(seed);
+}
+
+void CGearIVFrameGenerator::Start(uint32_t seed)
 {
   m_frame.seed = seed;
   m_frame.number = 0;
   
-  if (skipFirstTwoFrames)
+  if (m_skipFirstTwoFrames)
   {
     // C-Gear starts on 'frame 3'
     m_IVRNG.NextIVWord();
@@ -71,7 +85,21 @@ HashedIVFrameGenerator::HashedIVFrameGenerator
   : m_RNG(seed.rawSeed >> 32), m_IVRNG(m_RNG, IVRNG::FrameType(frameType)),
     m_frame(seed)
 {
-  if (Game::IsBlack2White2(seed.parameters.version))
+  Start();
+}
+
+void HashedIVFrameGenerator::Reseed(const HashedSeed &seed)
+{
+  m_RNG.Seed(seed.rawSeed >> 32);
+  m_IVRNG.Reset();
+  m_frame.seed = seed;
+  
+  Start();
+}
+
+void HashedIVFrameGenerator::Start()
+{
+  if (Game::IsBlack2White2(m_frame.seed.parameters.version))
   {
     // b2w2 skips first 2 frames
     m_IVRNG.NextIVWord();
@@ -106,25 +134,63 @@ Gen5PIDFrameGenerator::Gen5PIDFrameGenerator
                    s_FrameGeneratorInfo[parameters.frameType].b2w2EsvGenerator :
                    s_FrameGeneratorInfo[parameters.frameType].bwEsvGenerator),
     m_RNG(seed.rawSeed), m_frame(seed), m_parameters(parameters),
-    m_shinyChances((m_parameters.hasShinyCharm &&
-                    Game::IsBlack2White2(m_frame.seed.parameters.version)) ?
-                      3 : 1)
+    m_shinyChances(1)
 {
+  Start();
+}
+
+Gen5PIDFrameGenerator::Gen5PIDFrameGenerator
+  (const HashedSeed &seed, const HashedSeed::SkippedPIDFrames &skippedFrames,
+   const Gen5PIDFrameGenerator::Parameters &parameters)
+  : m_PIDGenerator(s_FrameGeneratorInfo[parameters.frameType].pidGenerator),
+    m_PIDFrameGenerator
+      (s_FrameGeneratorInfo[parameters.frameType].pidFrameGenerator),
+    m_ESVGenerator(parameters.isBlack2White2 ?
+                   s_FrameGeneratorInfo[parameters.frameType].b2w2EsvGenerator :
+                   s_FrameGeneratorInfo[parameters.frameType].bwEsvGenerator),
+    m_RNG(seed.rawSeed), m_frame(seed), m_parameters(parameters),
+    m_shinyChances(1)
+{
+  Start(skippedFrames);
+}
+
+void Gen5PIDFrameGenerator::Reseed(const HashedSeed &seed)
+{
+  m_RNG.Seed(seed.rawSeed);
+  m_frame.seed = seed;
+  
+  Start();
+}
+
+void Gen5PIDFrameGenerator::Start()
+{
+  if (m_parameters.startFromLowestFrame)
+    Start(m_frame.seed.CalculateSkippedPIDFrames(m_parameters.memoryLinkUsed));
+  else
+    Start(HashedSeed::SkippedPIDFrames());
+}
+
+void Gen5PIDFrameGenerator::Start
+  (const HashedSeed::SkippedPIDFrames &skippedFrames)
+{
+  m_shinyChances = (m_parameters.hasShinyCharm &&
+                    Game::IsBlack2White2(m_frame.seed.parameters.version)) ?
+                      3 : 1;
+  
   m_frame.number = 0;
   m_frame.rngValue = 0;
-  m_frame.leadAbility = parameters.leadAbility;
+  m_frame.leadAbility = m_parameters.leadAbility;
   m_frame.isEncounter = true;
   m_frame.encounterItem = EncounterItem::NONE;
-  m_frame.abilityActivated = (parameters.frameType != EntraLinkFrame);
+  m_frame.abilityActivated = (m_parameters.frameType != EntraLinkFrame);
   m_frame.esv = ESV::NO_SLOT;
   m_frame.heldItem = HeldItem::NO_ITEM;
   
-  if (parameters.startFromLowestFrame)
+  if (m_parameters.startFromLowestFrame)
   {
-    uint32_t  skippedFrames =
-      seed.GetSkippedPIDFrames(parameters.memoryLinkUsed);
-    m_RNG.AdvanceBuffer(skippedFrames);
-    m_frame.number += skippedFrames;
+    // reseeding from after the skipped frames beats stepping through them
+    m_RNG.Seed(skippedFrames.seed);
+    m_frame.number = skippedFrames.count;
   }
 }
 
@@ -639,37 +705,70 @@ void Gen5PIDFrameGenerator::NextHeldItem()
 }
 
 
+namespace
+{
+
+static bool IsGLANCard(const WonderCardFrameGenerator::Parameters &parameters)
+{
+  return (parameters.cardNature == Nature::ANY) &&
+         ((parameters.cardGender == Gender::FEMALE) ||
+          (parameters.cardGender == Gender::MALE));
+}
+
+// jump over the 'unused' frames instead of stepping through them
+static uint64_t WonderCardIVSeed(uint64_t rawSeed, bool isGLAN)
+{
+  LCRNG5  rng(rawSeed);
+  
+  rng.AdvanceFrames(isGLAN ? 24 : 22);
+  
+  return rng.Seed();
+}
+
+}
+
 WonderCardFrameGenerator::WonderCardFrameGenerator(const HashedSeed &seed,
                                                    const Parameters &parameters)
   : m_initialValueRNG(seed.rawSeed),
-    m_RNG(seed.rawSeed), m_IVRNG(m_RNG, IVRNG::Normal),
+    m_RNG(WonderCardIVSeed(seed.rawSeed, IsGLANCard(parameters))),
+    m_IVRNG(m_RNG, IVRNG::Normal),
     m_frame(seed),
     m_parameters(parameters),
-    m_isGLAN((parameters.cardNature == Nature::ANY) &&
-             ((parameters.cardGender == Gender::FEMALE) ||
-              (parameters.cardGender == Gender::MALE)))
+    m_isGLAN(IsGLANCard(parameters))
 {
-  // skip over IVs buffered in IVRNG
-  for (uint32_t i = 0; i < 5; ++i)
-    m_RNG.AdvanceBuffer();
-  
-  // skip over 'unused' frames
-  uint32_t  ivSkip = m_isGLAN ? 24 : 22;
-  for (uint32_t i = 0; i < ivSkip; ++i)
-  {
-    m_RNG.AdvanceBuffer();
-    m_IVRNG.NextIVWord();
-  }
+  Start();
+}
+
+void WonderCardFrameGenerator::Reseed(const HashedSeed &seed)
+{
+  m_initialValueRNG.Seed(seed.rawSeed);
+  m_RNG.Seed(WonderCardIVSeed(seed.rawSeed, m_isGLAN));
+  m_IVRNG.Reset();
+  m_frame.seed = seed;
   
+  Start();
+}
+
+void WonderCardFrameGenerator::Start()
+{
   m_frame.number = 0;
   m_frame.hasHiddenAbility = m_parameters.cardAbility == Ability::HIDDEN;
   
-  if (parameters.startFromLowestFrame)
+  if (m_parameters.startFromLowestFrame)
   {
-    uint32_t  skippedFrames =
-      seed.GetSkippedPIDFrames(parameters.memoryLinkUsed);
-    SkipFrames(skippedFrames);
+    HashedSeed::SkippedPIDFrames  skippedFrames =
+      m_frame.seed.CalculateSkippedPIDFrames(m_parameters.memoryLinkUsed);
+    
+    // reseed all three RNGs from after the skipped frames, rather than
+    // stepping each of them through the frames
+    m_initialValueRNG.Seed(skippedFrames.seed);
+    m_RNG.Seed(WonderCardIVSeed(skippedFrames.seed, m_isGLAN));
+    m_IVRNG.Reset();
+    m_frame.number = skippedFrames.count;
   }
+  
+  // skip over IVs buffered in IVRNG
+  m_RNG.AdvanceBuffer(5);
 }
 
 void WonderCardFrameGenerator::SkipFrames(uint32_t numFrames)
@@ -759,6 +858,24 @@ Gen5BreedingFrameGenerator::Gen5BreedingFrameGenerator
   m_frame.number = 0;
 }
 
+void Gen5BreedingFrameGenerator::Reseed(const HashedSeed &seed)
+{
+  m_NextSeed = seed.rawSeed;
+  m_RNG.Seed(seed.rawSeed);
+  m_frame.seed = seed;
+  m_frame.number = 0;
+}
+
+void Gen5BreedingFrameGenerator::SkipFrames(uint32_t numFrames)
+{
+  RNG  rng(m_NextSeed);
+  
+  rng.AdvanceFrames(numFrames);
+  
+  m_NextSeed = rng.Seed();
+  m_frame.number += numFrames;
+}
+
 void Gen5BreedingFrameGenerator::AdvanceFrame()
 {
   m_frame.ResetInheritance();
@@ -832,27 +949,40 @@ void Gen5BreedingFrameGenerator::AdvanceFrame()
 }
 
 
+namespace
+{
+
+// Returns the seed for a buffered PID RNG which, after a single
+// AdvanceBuffer(), is positioned as though it had been seeded with the raw
+// seed and advanced past the skipped PID frames plus extraFrames.
+// This reuses the post-skip seed rather than stepping through those
+// frames a second time.
+static uint64_t BufferedPIDRNGSeed(const HashedSeed &seed, bool memoryLinkUsed,
+                                   uint32_t extraFrames)
+{
+  HashedSeed::SkippedPIDFrames  skipped =
+    seed.CalculateSkippedPIDFrames(memoryLinkUsed);
+  
+  if (extraFrames == 0)
+    return LCRNG5_R::NextForSeed(skipped.seed);
+  
+  LCRNG5  rng(skipped.seed);
+  rng.AdvanceFrames(extraFrames - 1);
+  
+  return rng.Seed();
+}
+
+}
+
 DreamRadarFrameGenerator::DreamRadarFrameGenerator(const HashedSeed &seed,
                                                    const Parameters &parameters)
-  : m_PIDRNG(seed.rawSeed),
+  : m_PIDRNG(BufferedPIDRNGSeed(seed, parameters.memoryLinkUsed,
+                                parameters.memoryLinkUsed ? 0 : 1)),
     m_MTRNG(seed.rawSeed >> 32), m_IVRNG(m_MTRNG, IVRNG::Normal),
     m_frame(seed),
     m_parameters(parameters),
     m_pidAdvancements(parameters.GetPIDRNGAdvancements())
 {
-  m_frame.number = 0;
-  
-  int32_t  skippedFrames = seed.GetSkippedPIDFrames(parameters.memoryLinkUsed);
-  m_PIDRNG.AdvanceBuffer(skippedFrames);
-  
-  if (!parameters.memoryLinkUsed)
-    m_PIDRNG.AdvanceBuffer();
-  
-  // start from (b2w2) IV frame 8 (bw frame 10)
-  skippedFrames = 9;
-  while (skippedFrames-- > 0)
-    m_IVRNG.NextIVWord();
-  
   switch (parameters.frameType)
   {
   case GenieFrame:
@@ -871,8 +1001,29 @@ DreamRadarFrameGenerator::DreamRadarFrameGenerator(const HashedSeed &seed,
     break;
   }
   
-  // skip over IV frames
-  skippedFrames = (m_parameters.slot - 1) * 13;
+  Start();
+}
+
+void DreamRadarFrameGenerator::Reseed(const HashedSeed &seed)
+{
+  m_PIDRNG.Seed(BufferedPIDRNGSeed(seed, m_parameters.memoryLinkUsed,
+                                   m_parameters.memoryLinkUsed ? 0 : 1));
+  m_MTRNG.Seed(seed.rawSeed >> 32);
+  m_IVRNG.Reset();
+  m_frame.seed = seed;
+  
+  Start();
+}
+
+void DreamRadarFrameGenerator::Start()
+{
+  m_frame.number = 0;
+  
+  m_PIDRNG.AdvanceBuffer();
+  
+  // start from (b2w2) IV frame 8 (bw frame 10), then skip over IV frames
+  // of earlier slots
+  uint32_t  skippedFrames = 9 + ((m_parameters.slot - 1) * 13);
   while (skippedFrames-- > 0)
     m_IVRNG.NextIVWord();
 }
@@ -977,13 +1128,21 @@ static uint32_t GetHiddenHollowSpawnSlot(uint32_t value)
 
 HiddenHollowSpawnFrameGenerator::HiddenHollowSpawnFrameGenerator
   (const HashedSeed &seed, bool memoryLinkUsed)
-  : m_PIDRNG(seed.rawSeed),
-    m_frame(seed)
+  : m_PIDRNG(BufferedPIDRNGSeed(seed, memoryLinkUsed, 0)),
+    m_frame(seed), m_memoryLinkUsed(memoryLinkUsed)
 {
   m_frame.number = 0;
   
-  int32_t  skippedFrames = seed.GetSkippedPIDFrames(memoryLinkUsed);
-  m_PIDRNG.AdvanceBuffer(skippedFrames);
+  m_PIDRNG.AdvanceBuffer();
+}
+
+void HiddenHollowSpawnFrameGenerator::Reseed(const HashedSeed &seed)
+{
+  m_PIDRNG.Seed(BufferedPIDRNGSeed(seed, m_memoryLinkUsed, 0));
+  m_frame.seed = seed;
+  m_frame.number = 0;
+  
+  m_PIDRNG.AdvanceBuffer();
 }
 
 void HiddenHollowSpawnFrameGenerator::SkipFrames(uint32_t numFrames)
@@ -49,6 +49,14 @@ public:
     m_frame.number = 0;
   }
   
+  void Reseed(uint32_t seed)
+  {
+    m_RNG.Seed(seed);
+    
+    m_frame.seed = seed;
+    m_frame.number = 0;
+  }
+  
   void SkipFrames(uint32_t numFrames)
   {
     m_RNG.AdvanceBuffer(numFrames);
@@ -122,11 +130,15 @@ public:
     : m_NextSeed(seed), m_RNG(seed), m_PIDRNG(m_RNG), m_IVRNG(m_RNG),
       m_parameters(parameters)
   {
-    m_frame.seed = seed;
-    m_frame.number = 0;
-    m_frame.synched = false;
-    m_frame.isEncounter = true;
-    m_frame.esv = ESV::Value(0);
+    ResetFrame(seed);
+  }
+  
+  void Reseed(uint32_t seed)
+  {
+    m_NextSeed = seed;
+    m_RNG.Seed(seed);
+    
+    ResetFrame(seed);
   }
   
   void SkipFrames(uint32_t numFrames)
@@ -214,6 +226,15 @@ public:
   //uint32_t CurrentSeed() { return m_RNG.PeekNext(); }
   
 private:
+  void ResetFrame(uint32_t seed)
+  {
+    m_frame.seed = seed;
+    m_frame.number = 0;
+    m_frame.synched = false;
+    m_frame.isEncounter = true;
+    m_frame.esv = ESV::Value(0);
+  }
+  
   bool IsFishingEncounter(uint32_t threshold)
   {
     return Method::CalculatePercentage(m_RNG.Next()) < threshold;
@@ -301,6 +322,14 @@ public:
     m_frame.number = 0;
   }
   
+  void Reseed(uint32_t seed)
+  {
+    m_RNG.Seed(seed);
+    
+    m_frame.seed = seed;
+    m_frame.number = 0;
+  }
+  
   void SkipFrames(uint32_t numFrames)
   {
     uint32_t  i = 0;
@@ -352,6 +381,14 @@ public:
     m_frame.number = 0;
   }
   
+  void Reseed(uint32_t seed)
+  {
+    m_RNG.Seed(seed);
+    
+    m_frame.seed = seed;
+    m_frame.number = 0;
+  }
+  
   void SkipFrames(uint32_t numFrames)
   {
     m_RNG.AdvanceBuffer(numFrames);
@@ -465,6 +502,16 @@ public:
     m_RNG.Next();
   }
   
+  void Reseed(uint32_t seed)
+  {
+    m_RNG.Seed(seed);
+    
+    m_frame.seed = seed;
+    m_frame.number = 0;
+    
+    m_RNG.Next();
+  }
+  
   void SkipFrames(uint32_t numFrames)
   {
     uint32_t  i = 0;
@@ -508,6 +555,8 @@ public:
   CGearIVFrameGenerator(uint32_t seed, FrameType frameType,
                         bool skipFirstTwoFrames = true);
   
+  void Reseed(uint32_t seed);
+  
   void SkipFrames(uint32_t numFrames);
   
   void AdvanceFrame();
@@ -515,9 +564,12 @@ public:
   const Frame& CurrentFrame() { return m_frame; }
   
 private:
+  void Start(uint32_t seed);
+  
   RNG             m_RNG;
   IVRNG           m_IVRNG;
   Frame           m_frame;
+  const bool      m_skipFirstTwoFrames;
 };
 
 
@@ -537,6 +589,8 @@ public:
   
   HashedIVFrameGenerator(const HashedSeed &seed, FrameType frameType);
   
+  void Reseed(const HashedSeed &seed);
+  
   void SkipFrames(uint32_t numFrames);
   
   void AdvanceFrame();
@@ -544,6 +598,8 @@ public:
   const Frame& CurrentFrame() { return m_frame; }
   
 private:
+  void Start();
+  
   RNG       m_RNG;
   IVRNG     m_IVRNG;
   Frame     m_frame;
@@ -602,6 +658,13 @@ public:
   
   Gen5PIDFrameGenerator(const HashedSeed &seed, const Parameters &parameters);
   
+  // for callers that have already calculated the seed's skipped frames
+  Gen5PIDFrameGenerator(const HashedSeed &seed,
+                        const HashedSeed::SkippedPIDFrames &skippedFrames,
+                        const Parameters &parameters);
+  
+  void Reseed(const HashedSeed &seed);
+  
   void SkipFrames(uint32_t numFrames);
   
   void AdvanceFrame();
@@ -611,6 +674,9 @@ public:
   FrameType GetFrameType() const { return m_parameters.frameType; }
   
 private:
+  void Start();
+  void Start(const HashedSeed::SkippedPIDFrames &skippedFrames);
+  
   typedef void (Gen5PIDFrameGenerator::*PIDGenerator)();
   
   const PIDGenerator  m_PIDGenerator;
@@ -670,7 +736,7 @@ private:
   RNG               m_RNG;
   Frame             m_frame;
   const Parameters  m_parameters;
-  const uint32_t    m_shinyChances;
+  uint32_t          m_shinyChances;
 };
 
 
@@ -706,6 +772,8 @@ public:
   WonderCardFrameGenerator(const HashedSeed &seed,
                            const Parameters &parameters);
   
+  void Reseed(const HashedSeed &seed);
+  
   void SkipFrames(uint32_t numFrames);
   
   void AdvanceFrame();
@@ -713,6 +781,8 @@ public:
   const Frame& CurrentFrame() { return m_frame; }
   
 private:
+  void Start();
+  
   LCRNG5            m_initialValueRNG;
   RNG               m_RNG;
   IVRNG             m_IVRNG;
@@ -737,6 +807,14 @@ public:
     m_frame.number = 0;
   }
   
+  void Reseed(const HashedSeed &seed)
+  {
+    m_RNG.Seed(seed.rawSeed);
+    
+    m_frame.seed = seed;
+    m_frame.number = 0;
+  }
+  
   void SkipFrames(uint32_t numFrames)
   {
     uint32_t  i = 0;
@@ -788,6 +866,10 @@ public:
   Gen5BreedingFrameGenerator(const HashedSeed &seed,
                              const Parameters &parameters);
   
+  void Reseed(const HashedSeed &seed);
+  
+  void SkipFrames(uint32_t numFrames);
+  
   void AdvanceFrame();
   
   const Frame& CurrentFrame() { return m_frame; }
@@ -864,6 +946,8 @@ public:
   DreamRadarFrameGenerator(const HashedSeed &seed,
                            const Parameters &parameters);
   
+  void Reseed(const HashedSeed &seed);
+  
   void SkipFrames(uint32_t numFrames);
   
   void AdvanceFrame();
@@ -876,6 +960,8 @@ public:
                                           const Parameters &parameters);
   
 private:
+  void Start();
+  
   PIDRNG          m_PIDRNG;
   MTRNG           m_MTRNG;
   IVRNG           m_IVRNG;
@@ -894,6 +980,8 @@ public:
   
   HiddenHollowSpawnFrameGenerator(const HashedSeed &seed, bool memoryLinkUsed);
   
+  void Reseed(const HashedSeed &seed);
+  
   void SkipFrames(uint32_t numFrames);
   
   void AdvanceFrame();
@@ -901,8 +989,9 @@ public:
   const Frame& CurrentFrame() { return m_frame; }
   
 private:
-  PIDRNG  m_PIDRNG;
-  Frame   m_frame;
+  PIDRNG      m_PIDRNG;
+  Frame       m_frame;
+  const bool  m_memoryLinkUsed;
 };
 
 }
@@ -0,0 +1,187 @@
+/*
+  Copyright (C) 2012 chiizu
+  chiizu.pprng@gmail.com
+  
+  This file is part of libpprng.
+  
+  libpprng is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  libpprng is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License
+  along with libpprng.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "Gen34PIDSeedSearcher.h"
+#include "LinearCongruentialRNG.h"
+#include "TimeSeed.h"
+
+#include <list>
+
+namespace pprng
+{
+
+namespace
+{
+
+// The first of the two PID calls returns an RNG state whose upper half is the
+// PID's lower half, so only the state's lower half is unknown.
+class PIDStateGenerator
+{
+public:
+  typedef uint32_t  SeedType;
+  typedef uint32_t  SeedCountType;
+  
+  enum { SeedsPerChunk = 0x1000 };
+  
+  PIDStateGenerator(PID pid)
+    : m_stateHigh(pid.word << 16), m_lowHalf(0xffffffff),
+      m_numLowHalves(0x10000)
+  {}
+  
+  SeedCountType NumberOfSeeds() const { return m_numLowHalves; }
+  
+  SeedType Next() { return m_stateHigh | ++m_lowHalf; }
+  
+  std::list<PIDStateGenerator> Split(uint32_t parts)
+  {
+    std::list<PIDStateGenerator>  result;
+    
+    uint32_t  first = 0;
+    for (uint32_t i = 0; i < parts; ++i)
+    {
+      uint32_t  next = (m_numLowHalves * (i + 1)) / parts;
+      
+      PIDStateGenerator  part(*this);
+      part.m_lowHalf = m_lowHalf + first;
+      part.m_numLowHalves = next - first;
+      
+      result.push_back(part);
+      
+      first = next;
+    }
+    
+    return result;
+  }
+  
+private:
+  const uint32_t  m_stateHigh;
+  uint32_t        m_lowHalf;
+  uint32_t        m_numLowHalves;
+};
+
+// the second PID call must return the PID's upper half
+struct PIDStateChecker
+{
+  PIDStateChecker(PID pid)
+    : m_pidHigh(pid.word >> 16)
+  {}
+  
+  bool operator()(uint32_t state) const
+  {
+    return (LCRNG34::NextForSeed(state) >> 16) == m_pidHigh;
+  }
+  
+  const uint32_t  m_pidHigh;
+};
+
+template <int Method>
+struct TimeSeedSearcher
+{
+  typedef Gen34Frame  ResultType;
+  
+  TimeSeedSearcher(const Gen34PIDSeedSearcher::Criteria &criteria)
+    : m_criteria(criteria)
+  {}
+  
+  template <class ResultCallback>
+  void Search(uint32_t pidState, const PIDStateChecker &checker,
+              const ResultCallback &resultHandler)
+  {
+    if (!checker(pidState))
+      return;
+    
+    // frame N's first PID call is the state N frames after the seed
+    uint32_t  seed = pidState;
+    for (uint32_t frameNumber = 1; frameNumber <= m_criteria.frame.max;
+         ++frameNumber)
+    {
+      seed = LCRNG34_R::NextForSeed(seed);
+      
+      if (frameNumber < m_criteria.frame.min)
+        continue;
+      
+      TimeSeed  ts(seed);
+      
+      if (ts.IsValid() &&
+          (ts.BaseDelay() >= m_criteria.delay.min) &&
+          (ts.BaseDelay() <= m_criteria.delay.max))
+      {
+        Gen34FrameGenerator<Method>  frameGenerator(seed);
+        
+        frameGenerator.SkipFrames(frameNumber - 1);
+        frameGenerator.AdvanceFrame();
+        
+        resultHandler(frameGenerator.CurrentFrame());
+      }
+    }
+  }
+  
+  const Gen34PIDSeedSearcher::Criteria  &m_criteria;
+};
+
+template <int Method>
+static void SearchMethod
+  (const Gen34PIDSeedSearcher::Criteria &criteria,
+   const Gen34PIDSeedSearcher::ResultCallback &resultHandler,
+   const SearchRunner::ProgressCallback &progressHandler)
+{
+  PIDStateGenerator         seedGenerator(criteria.pid);
+  TimeSeedSearcher<Method>  seedSearcher(criteria);
+  PIDStateChecker           stateChecker(criteria.pid);
+  SearchRunner              searcher;
+  
+  searcher.SearchThreaded(seedGenerator, seedSearcher, stateChecker,
+                          resultHandler, progressHandler);
+}
+
+}
+
+uint64_t Gen34PIDSeedSearcher::Criteria::ExpectedNumberOfResults() const
+{
+  // on average one RNG state gives the PID, and each frame back from it is
+  // a valid time seed if its hour and delay are in range
+  uint64_t  numFrames = frame.max - frame.min + 1;
+  uint64_t  delays = delay.max - delay.min + 1;
+  
+  return (numFrames * 24 * delays / (256 * 65536)) + 1;
+}
+
+void Gen34PIDSeedSearcher::Search
+  (const Criteria &criteria, const ResultCallback &resultHandler,
+   const SearchRunner::ProgressCallback &progressHandler)
+{
+  switch (criteria.method)
+  {
+  case 2:
+    SearchMethod<2>(criteria, resultHandler, progressHandler);
+    break;
+    
+  case 4:
+    SearchMethod<4>(criteria, resultHandler, progressHandler);
+    break;
+    
+  default:
+    SearchMethod<1>(criteria, resultHandler, progressHandler);
+    break;
+  }
+}
+
+}
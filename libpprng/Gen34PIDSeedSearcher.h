@@ -0,0 +1,67 @@
+/*
+  Copyright (C) 2012 chiizu
+  chiizu.pprng@gmail.com
+  
+  This file is part of libpprng.
+  
+  libpprng is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  libpprng is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License
+  along with libpprng.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef GEN_3_4_PID_SEED_SEARCHER_H
+#define GEN_3_4_PID_SEED_SEARCHER_H
+
+#include "PPRNGTypes.h"
+#include "SearchCriteria.h"
+#include "SearchRunner.h"
+#include "FrameGenerator.h"
+
+#include <boost/function.hpp>
+
+namespace pprng
+{
+
+// Finds the time seeds and frames giving an exact PID.  Rather than scanning
+// the time seed space, the RNG states producing the PID are solved for
+// directly, then walked back to any valid time seeds within the frame range.
+class Gen34PIDSeedSearcher
+{
+public:
+  struct Criteria
+  {
+    PID                          pid;
+    uint32_t                     method;  // 1, 2 or 4
+    SearchCriteria::DelayRange   delay;
+    SearchCriteria::FrameRange   frame;
+    
+    Criteria()
+      : pid(), method(1), delay(), frame()
+    {}
+    
+    uint64_t ExpectedNumberOfResults() const;
+  };
+  
+  typedef Gen34Frame                                 ResultType;
+  typedef boost::function<void (const ResultType*, std::size_t)>
+                                                     ResultCallback;
+  
+  Gen34PIDSeedSearcher() {}
+  
+  void Search(const Criteria &criteria, const ResultCallback &resultHandler,
+              const SearchRunner::ProgressCallback &progressHandler);
+};
+
+}
+
+#endif
@@ -77,9 +77,9 @@ struct FrameGeneratorFactory
 {
   typedef Method1FrameGenerator  FrameGenerator;
   
-  Method1FrameGenerator operator()(uint32_t seed) const
+  Method1FrameGenerator* operator()(uint32_t seed) const
   {
-    return Method1FrameGenerator(seed);
+    return new Method1FrameGenerator(seed);
   }
 };
 
@@ -124,8 +124,8 @@ void Gen34SeedSearcher::Search
   
   SearchRunner              searcher;
   
-  searcher.Search(seedGenerator, seedSearcher, frameChecker,
-                  resultHandler, progressHandler);
+  searcher.SearchThreaded(seedGenerator, seedSearcher, frameChecker,
+                          resultHandler, progressHandler);
 }
 
 }
@@ -144,30 +144,19 @@ std::vector<IVRange> GenerateIVRanges(OptionalIVs parent1IVs,
 }
 
 
+// checks the egg IVs in each search thread, so that the result handler only
+// has to build the matching frames
 struct FrameChecker
 {
-  bool operator()(const Gen4BreedingFrame &frame) const
-  {
-    return true;
-  }
-};
-
-
-struct FrameResultHandler
-{
-  FrameResultHandler(const Gen4EggIVSeedSearcher::Criteria &criteria,
-                     const Gen4EggIVSeedSearcher::ResultCallback &resultHandler)
-    : m_criteria(criteria), m_resultHandler(resultHandler)
+  FrameChecker(const Gen4EggIVSeedSearcher::Criteria &criteria)
+    : m_criteria(criteria)
   {}
   
-  void operator()(const Gen4BreedingFrame &frame) const
+  bool operator()(const Gen4BreedingFrame &frame) const
   {
     Gen4EggIVFrame  eggFrame(frame, m_criteria.aIVs, m_criteria.bIVs);
     
-    if (CheckIVs(eggFrame.ivs) && CheckHiddenPower(eggFrame.ivs))
-    {
-      m_resultHandler(eggFrame);
-    }
+    return CheckIVs(eggFrame.ivs) && CheckHiddenPower(eggFrame.ivs);
   }
   
   bool CheckIVs(const OptionalIVs &ivs) const
@@ -185,6 +174,32 @@ struct FrameResultHandler
                                             oivs.values.HiddenPower()));
   }
   
+  const Gen4EggIVSeedSearcher::Criteria  &m_criteria;
+};
+
+
+struct FrameResultHandler
+{
+  FrameResultHandler(const Gen4EggIVSeedSearcher::Criteria &criteria,
+                     const Gen4EggIVSeedSearcher::ResultCallback &resultHandler)
+    : m_criteria(criteria), m_resultHandler(resultHandler)
+  {}
+  
+  void operator()(const Gen4BreedingFrame *frames, std::size_t numFrames) const
+  {
+    std::vector<Gen4EggIVFrame>  results;
+    
+    results.reserve(numFrames);
+    
+    for (std::size_t i = 0; i < numFrames; ++i)
+    {
+      results.push_back
+        (Gen4EggIVFrame(frames[i], m_criteria.aIVs, m_criteria.bIVs));
+    }
+    
+    m_resultHandler(&results[0], results.size());
+  }
+  
   const Gen4EggIVSeedSearcher::Criteria        &m_criteria;
   const Gen4EggIVSeedSearcher::ResultCallback  &m_resultHandler;
 };
@@ -198,9 +213,9 @@ struct FrameGeneratorFactory
     : m_version(version)
   {}
   
-  Gen4BreedingFrameGenerator operator()(uint32_t seed) const
+  Gen4BreedingFrameGenerator* operator()(uint32_t seed) const
   {
-    return Gen4BreedingFrameGenerator(seed, m_version);
+    return new Gen4BreedingFrameGenerator(seed, m_version);
   }
   
   const Game::Version  m_version;
@@ -251,12 +266,12 @@ void Gen4EggIVSeedSearcher::Search
   
   SeedFrameSearcher<FrameGeneratorFactory>  seedSearcher(frameGeneratorFactory,
                                                          criteria.frame);
-  FrameChecker           frameChecker;
+  FrameChecker           frameChecker(criteria);
   FrameResultHandler     frameResultHandler(criteria, resultHandler);
   SearchRunner           searcher;
   
-  searcher.Search(seedGenerator, seedSearcher, frameChecker,
-                  frameResultHandler, progressHandler);
+  searcher.SearchThreaded(seedGenerator, seedSearcher, frameChecker,
+                          frameResultHandler, progressHandler);
 }
 
 }
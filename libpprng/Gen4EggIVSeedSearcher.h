@@ -48,7 +48,8 @@ public:
   };
   
   typedef Gen4EggIVFrame                             ResultType;
-  typedef boost::function<void (const ResultType&)>  ResultCallback;
+  typedef boost::function<void (const ResultType*, std::size_t)>
+                                                     ResultCallback;
   
   Gen4EggIVSeedSearcher() {}
   
@@ -77,9 +77,9 @@ struct FrameGeneratorFactory
     : m_parameters(params)
   {}
   
-  Gen4EggPIDFrameGenerator operator()(uint32_t seed) const
+  Gen4EggPIDFrameGenerator* operator()(uint32_t seed) const
   {
-    return Gen4EggPIDFrameGenerator(seed, m_parameters);
+    return new Gen4EggPIDFrameGenerator(seed, m_parameters);
   }
   
   const Gen4EggPIDFrameGenerator::Parameters  &m_parameters;
@@ -130,8 +130,8 @@ void Gen4EggPIDSeedSearcher::Search
   
   SearchRunner           searcher;
   
-  searcher.Search(seedGenerator, seedSearcher, frameChecker,
-                  resultHandler, progressHandler);
+  searcher.SearchThreaded(seedGenerator, seedSearcher, frameChecker,
+                          resultHandler, progressHandler);
 }
 
 }
@@ -47,7 +47,8 @@ public:
   };
   
   typedef Gen4EggPIDFrameGenerator::Frame            ResultType;
-  typedef boost::function<void (const ResultType&)>  ResultCallback;
+  typedef boost::function<void (const ResultType*, std::size_t)>
+                                                     ResultCallback;
   
   Gen4EggPIDSeedSearcher() {}
   
@@ -0,0 +1,343 @@
+/*
+  Copyright (C) 2012 chiizu
+  chiizu.pprng@gmail.com
+  
+  This file is part of libpprng.
+  
+  libpprng is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  libpprng is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License
+  along with libpprng.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "Gen4EncounterSeedSearcher.h"
+#include "LinearCongruentialRNG.h"
+#include "TimeSeed.h"
+
+namespace pprng
+{
+
+namespace
+{
+
+typedef DPPtEncounterFrameGenerator  EncounterFrameGenerator;
+
+struct FrameChecker
+{
+  FrameChecker(const Gen4EncounterSeedSearcher::Criteria &criteria)
+    : m_criteria(criteria)
+  {}
+  
+  bool operator()(const Gen34Frame &frame) const
+  {
+    return CheckShiny(frame.pid) && CheckNature(frame.pid) &&
+           CheckAbility(frame.pid) && CheckGender(frame.pid) &&
+           CheckIVs(frame.ivs) && CheckHiddenPower(frame.ivs);
+  }
+  
+  bool CheckShiny(const PID &pid) const
+  {
+    return !m_criteria.shinyOnly || pid.IsShiny(m_criteria.tid, m_criteria.sid);
+  }
+  
+  bool CheckNature(const PID &pid) const
+  {
+    return m_criteria.pid.CheckNature(pid.Gen34Nature());
+  }
+  
+  bool CheckAbility(const PID &pid) const
+  {
+    return (m_criteria.pid.ability == Ability::ANY) ||
+           (m_criteria.pid.ability == pid.Gen34Ability());
+  }
+  
+  bool CheckGender(const PID &pid) const
+  {
+    return Gender::GenderValueMatches(pid.GenderValue(),
+                                      m_criteria.pid.gender,
+                                      m_criteria.pid.genderRatio);
+  }
+  
+  bool CheckIVs(const IVs &ivs) const
+  {
+    return ivs.betterThanOrEqual(m_criteria.ivs.min) &&
+           (m_criteria.ivs.max.isMax() ||
+            ivs.worseThanOrEqual(m_criteria.ivs.max));
+  }
+
+  bool CheckHiddenPower(const IVs &ivs) const
+  {
+    return m_criteria.ivs.CheckHiddenPower(ivs.HiddenType(), ivs.HiddenPower());
+  }
+  
+  const Gen4EncounterSeedSearcher::Criteria  &m_criteria;
+};
+
+// Each IV seed is the RNG state just before the PID of a Method 1 frame.
+// Working backwards from there, every earlier PID attempt must have been
+// rejected for having the wrong nature, and the call before each attempt is
+// a possible Synchronize check or nature call, which fixes where the
+// encounter started.
+template <class Method>
+class SeedSearcher
+{
+public:
+  typedef Gen4EncounterFrame  ResultType;
+  
+  SeedSearcher(const Gen4EncounterSeedSearcher::Criteria &criteria)
+    : m_criteria(criteria),
+      m_hasSyncLead(criteria.syncNature != Nature::ANY),
+      m_leadingCalls(EncounterFrameGenerator::MonsterFrameForEncounterType
+                       (criteria.encounterType) - 1)
+  {}
+  
+  template <class ResultCallback>
+  void Search(uint32_t seed, const FrameChecker &frameChecker,
+              const ResultCallback &resultHandler)
+  {
+    Method1FrameGenerator  frameGenerator(seed);
+    
+    frameGenerator.AdvanceFrame();
+    
+    const Gen34Frame  &frame = frameGenerator.CurrentFrame();
+    
+    if (!frameChecker(frame))
+      return;
+    
+    Nature::Type  nature = frame.pid.Gen34Nature();
+    LCRNG34_R     rng(frame.rngValue);
+    uint32_t      decisionValue = rng.Next();
+    uint32_t      numRejectedPIDs = 0;
+    
+    while (true)
+    {
+      CheckDecision(frame, nature, decisionValue, numRejectedPIDs,
+                    resultHandler);
+      
+      // the decision call would be the upper half of an earlier PID
+      PID  earlierPID((decisionValue & 0xffff0000) | (rng.Next() >> 16));
+      
+      if (earlierPID.Gen34Nature() == nature)
+        break;
+      
+      decisionValue = rng.Next();
+      ++numRejectedPIDs;
+    }
+  }
+  
+private:
+  // decisionValue is the call just before a run of rejected PIDs
+  template <class ResultCallback>
+  void CheckDecision(const Gen34Frame &frame, Nature::Type nature,
+                     uint32_t decisionValue, uint32_t numRejectedPIDs,
+                     const ResultCallback &resultHandler)
+  {
+    if (!m_hasSyncLead)
+    {
+      if (Method::DetermineNature(decisionValue) == nature)
+      {
+        CheckEncounter(frame, decisionValue, false,
+                       1 + (2 * numRejectedPIDs), resultHandler);
+      }
+    }
+    else
+    {
+      if (Method::DetermineSync(decisionValue) &&
+          (m_criteria.syncNature == nature))
+      {
+        CheckEncounter(frame, decisionValue, true,
+                       1 + (2 * numRejectedPIDs), resultHandler);
+      }
+      
+      uint32_t  syncValue = LCRNG34_R::NextForSeed(decisionValue);
+      
+      if ((Method::DetermineNature(decisionValue) == nature) &&
+          !Method::DetermineSync(syncValue))
+      {
+        CheckEncounter(frame, syncValue, false,
+                       2 + (2 * numRejectedPIDs), resultHandler);
+      }
+    }
+  }
+  
+  // firstLeadValue is the Synchronize check if there is one, or else the
+  // nature call
+  template <class ResultCallback>
+  void CheckEncounter(const Gen34Frame &frame, uint32_t firstLeadValue,
+                      bool synched, uint32_t method1Offset,
+                      const ResultCallback &resultHandler)
+  {
+    uint32_t  startValue = firstLeadValue;
+    
+    for (uint32_t i = 0; i < m_leadingCalls; ++i)
+      startValue = LCRNG34_R::NextForSeed(startValue);
+    
+    ESV::Value  esv = ESV::Value(0);
+    
+    if (!CheckSlot(startValue, esv))
+      return;
+    
+    Gen4EncounterFrame  result;
+    
+    result.rngValue = startValue;
+    result.isEncounter = true;
+    result.esv = esv;
+    result.synched = synched;
+    result.pid = frame.pid;
+    result.ivs = frame.ivs;
+    
+    // the encounter's frame N starts with the Nth call after the time seed
+    uint32_t  seed = startValue;
+    for (uint32_t frameNumber = 1; frameNumber <= m_criteria.frame.max;
+         ++frameNumber)
+    {
+      seed = LCRNG34_R::NextForSeed(seed);
+      
+      if (frameNumber < m_criteria.frame.min)
+        continue;
+      
+      TimeSeed  ts(seed);
+      
+      if (ts.IsValid() &&
+          (ts.BaseDelay() >= m_criteria.delay.min) &&
+          (ts.BaseDelay() <= m_criteria.delay.max))
+      {
+        result.seed = seed;
+        result.number = frameNumber;
+        result.method1Number = frameNumber + method1Offset;
+        
+        resultHandler(result);
+      }
+    }
+  }
+  
+  // matches the calls made by Gen4EncounterFrameGenerator
+  bool CheckSlot(uint32_t startValue, ESV::Value &esv) const
+  {
+    uint32_t  nextValue = LCRNG34::NextForSeed(startValue);
+    
+    switch (m_criteria.encounterType)
+    {
+    case EncounterFrameGenerator::GrassCaveEncounter:
+      esv = ESV::Gen4Land(Method::CalculatePercentage(startValue));
+      break;
+      
+    case EncounterFrameGenerator::SurfingEncounter:
+      esv = ESV::Gen4Surfing(Method::CalculatePercentage(startValue));
+      break;
+      
+    case EncounterFrameGenerator::OldRodFishingEncounter:
+      if (Method::CalculatePercentage(startValue) >= Method::OldRodThreshold)
+        return false;
+      esv = Method::OldRodESV(Method::CalculatePercentage(nextValue));
+      break;
+      
+    case EncounterFrameGenerator::GoodRodFishingEncounter:
+      if (Method::CalculatePercentage(startValue) >= Method::GoodRodThreshold)
+        return false;
+      esv = Method::GoodRodESV(Method::CalculatePercentage(nextValue));
+      break;
+      
+    case EncounterFrameGenerator::SuperRodFishingEncounter:
+      if (Method::CalculatePercentage(startValue) >= Method::SuperRodThreshold)
+        return false;
+      esv = Method::SuperRodESV(Method::CalculatePercentage(nextValue));
+      break;
+      
+    case EncounterFrameGenerator::StationaryEncounter:
+    default:
+      // no slot to check
+      return true;
+    }
+    
+    return (m_criteria.esvMask == 0) ||
+           ((m_criteria.esvMask & (0x1 << ESV::Slot(esv))) != 0);
+  }
+  
+  const Gen4EncounterSeedSearcher::Criteria  &m_criteria;
+  const bool                                 m_hasSyncLead;
+  const uint32_t                             m_leadingCalls;
+};
+
+template <class Method>
+static void SearchMethod
+  (const Gen4EncounterSeedSearcher::Criteria &criteria,
+   const Gen4EncounterSeedSearcher::ResultCallback &resultHandler,
+   const SearchRunner::ProgressCallback &progressHandler)
+{
+  Gen34IVSeedGenerator   seedGenerator(criteria.ivs.min, criteria.ivs.max);
+  SeedSearcher<Method>   seedSearcher(criteria);
+  FrameChecker           frameChecker(criteria);
+  SearchRunner           searcher;
+  
+  searcher.SearchThreaded(seedGenerator, seedSearcher, frameChecker,
+                          resultHandler, progressHandler);
+}
+
+}
+
+uint64_t Gen4EncounterSeedSearcher::Criteria::ExpectedNumberOfResults() const
+{
+  uint64_t  delays = delay.max - delay.min + 1;
+  
+  uint64_t  numSeeds = delays * 256 * 24;
+  
+  uint64_t  numFrames = frame.max - frame.min + 1;
+  
+  uint32_t  numIVs = IVs::CalculateNumberOfCombinations(ivs.min, ivs.max);
+  
+  uint64_t  natureMultiplier = pid.NumNatures(), natureDivisor = 25;
+  
+  uint64_t  shinyDivisor = shinyOnly ? 8192 : 1;
+  
+  // assume the wanted slots are among the commonest, at 20% each
+  uint64_t  slotMultiplier = 1, slotDivisor = 1;
+  if (esvMask != 0)
+  {
+    uint32_t  numSlots = 0, m = esvMask;
+    while (m != 0)
+    {
+      m &= m - 1;
+      ++numSlots;
+    }
+    
+    slotMultiplier = numSlots;
+    slotDivisor = 5;
+  }
+  
+  uint64_t  numResults = numFrames * numSeeds * numIVs * natureMultiplier *
+    slotMultiplier /
+    (32 * 32 * 32 * 32 * 32 * 32 * natureDivisor * shinyDivisor * slotDivisor);
+  
+  numResults = IVs::AdjustExpectedResultsForHiddenPower
+    (numResults, ivs.min, ivs.max, ivs.hiddenTypeMask, ivs.minHiddenPower);
+  
+  return numResults + 1;
+}
+
+void Gen4EncounterSeedSearcher::Search
+  (const Criteria &criteria, const ResultCallback &resultHandler,
+   const SearchRunner::ProgressCallback &progressHandler)
+{
+  if ((criteria.version == Game::HeartGoldVersion) ||
+      (criteria.version == Game::SoulSilverVersion))
+  {
+    SearchMethod<MethodK>(criteria, resultHandler, progressHandler);
+  }
+  else
+  {
+    SearchMethod<MethodJ>(criteria, resultHandler, progressHandler);
+  }
+}
+
+}
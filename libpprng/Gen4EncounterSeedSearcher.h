@@ -0,0 +1,87 @@
+/*
+  Copyright (C) 2012 chiizu
+  chiizu.pprng@gmail.com
+  
+  This file is part of libpprng.
+  
+  libpprng is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  libpprng is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License
+  along with libpprng.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef GEN_4_ENCOUNTER_SEED_SEARCHER_H
+#define GEN_4_ENCOUNTER_SEED_SEARCHER_H
+
+#include "PPRNGTypes.h"
+#include "SearchCriteria.h"
+#include "SearchRunner.h"
+#include "SeedGenerator.h"
+#include "FrameGenerator.h"
+
+#include <boost/function.hpp>
+
+namespace pprng
+{
+
+// Finds the time seeds and frames of Method J (DPPt) or Method K (HGSS) wild
+// encounters with the wanted IVs, PID, encounter slot and lead.  Candidate
+// IV words are generated directly, and each is walked back through the
+// nature search PID loop to the frames the encounter could have started on,
+// and from those to any valid time seeds within the frame range.
+class Gen4EncounterSeedSearcher
+{
+public:
+  struct Criteria : public SearchCriteria
+  {
+    Game::Version                version;
+    SearchCriteria::DelayRange   delay;
+    SearchCriteria::FrameRange   frame;
+    SearchCriteria::IVCriteria   ivs;
+    SearchCriteria::PIDCriteria  pid;
+    
+    bool                         shinyOnly;
+    uint32_t                     tid, sid;
+    
+    // the same encounter types are used for both methods
+    DPPtEncounterFrameGenerator::EncounterType  encounterType;
+    
+    // wanted slots of the encounter type, or 0 for any
+    uint32_t                     esvMask;
+    
+    // Nature::ANY without a Synchronize lead
+    Nature::Type                 syncNature;
+    
+    Criteria()
+      : version(Game::DiamondVersion), delay(), frame(), ivs(), pid(),
+        shinyOnly(false), tid(0), sid(0),
+        encounterType(DPPtEncounterFrameGenerator::GrassCaveEncounter),
+        esvMask(0), syncNature(Nature::ANY)
+    {}
+    
+    uint64_t ExpectedNumberOfResults() const;
+  };
+  
+  typedef Gen4EncounterFrame                         ResultType;
+  typedef boost::function<void (const ResultType*, std::size_t)>
+                                                     ResultCallback;
+  
+  Gen4EncounterSeedSearcher() {}
+  
+  void Search(const Criteria &criteria, const ResultCallback &resultHandler,
+              const SearchRunner::ProgressCallback &progressHandler);
+};
+
+}
+
+#endif
@@ -0,0 +1,254 @@
+/*
+  Copyright (C) 2012 chiizu
+  chiizu.pprng@gmail.com
+  
+  This file is part of libpprng.
+  
+  libpprng is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  libpprng is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License
+  along with libpprng.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "Gen4ObservationIndex.h"
+#include "LinearCongruentialRNG.h"
+#include "MersenneTwisterRNG.h"
+
+#include <algorithm>
+
+namespace pprng
+{
+
+namespace
+{
+
+static uint32_t Power(uint32_t radix, uint32_t exponent)
+{
+  uint32_t  result = 1;
+  
+  while (exponent-- > 0)
+    result *= radix;
+  
+  return result;
+}
+
+static bool CheckRoamerLocation(uint32_t location, uint32_t seedLocation)
+{
+  return (location < 1) || (location == seedLocation);
+}
+
+}
+
+Gen4ObservationIndex::Gen4ObservationIndex(const Parameters &parameters)
+  : m_parameters(parameters),
+    m_radix((parameters.observationType == CoinFlipObservations) ? 2 : 3),
+    m_numObservations(std::min(parameters.numObservations,
+                               uint32_t(MaxIndexedObservations))),
+    m_seeds(), m_keyStarts()
+{
+  uint32_t  minBase = m_parameters.minDelay + (m_parameters.fromYear - 2000);
+  uint32_t  maxBase = m_parameters.maxDelay + (m_parameters.toYear - 2000);
+  if (maxBase > 0xffff)
+    maxBase = 0xffff;
+  
+  uint32_t  numKeys = Power(m_radix, m_numObservations);
+  
+  m_keyStarts.assign(numKeys + 1, 0);
+  
+  // an empty window, or one wholly past the largest delay, leaves no seeds
+  if (minBase > maxBase)
+    return;
+  
+  uint32_t  numSeeds = (maxBase - minBase + 1) * 24 * 256;
+  
+  std::vector<uint32_t>  keys;
+  keys.reserve(numSeeds);
+  
+  for (uint32_t base = minBase; base <= maxBase; ++base)
+  {
+    for (uint32_t hour = 0; hour < 24; ++hour)
+    {
+      for (uint32_t dayMonthMinuteSecond = 0; dayMonthMinuteSecond < 256;
+           ++dayMonthMinuteSecond)
+      {
+        uint32_t  seed = (dayMonthMinuteSecond << 24) | (hour << 16) | base;
+        uint32_t  key = ObservationsKey(seed);
+        
+        keys.push_back(key);
+        ++m_keyStarts[key + 1];
+      }
+    }
+  }
+  
+  for (uint32_t i = 1; i <= numKeys; ++i)
+    m_keyStarts[i] += m_keyStarts[i - 1];
+  
+  // a counting sort, so the seeds of each key stay in the order generated
+  std::vector<uint32_t>  nextPosition(m_keyStarts.begin(),
+                                      m_keyStarts.end() - 1);
+  m_seeds.resize(keys.size());
+  
+  uint32_t  i = 0;
+  for (uint32_t base = minBase; base <= maxBase; ++base)
+  {
+    for (uint32_t hour = 0; hour < 24; ++hour)
+    {
+      for (uint32_t dayMonthMinuteSecond = 0; dayMonthMinuteSecond < 256;
+           ++dayMonthMinuteSecond)
+      {
+        uint32_t  seed = (dayMonthMinuteSecond << 24) | (hour << 16) | base;
+        
+        m_seeds[nextPosition[keys[i++]]++] = seed;
+      }
+    }
+  }
+}
+
+uint32_t Gen4ObservationIndex::ObservationsKey(uint32_t seed) const
+{
+  uint32_t  key = 0;
+  
+  if (m_parameters.observationType == CoinFlipObservations)
+  {
+    MTRNG  rng(seed);
+    
+    for (uint32_t i = 0; i < m_numObservations; ++i)
+      key = (key << 1) | CoinFlips::CalcResult(rng.Next());
+  }
+  else
+  {
+    HGSSRoamers  roamers(seed, m_parameters.raikouLocation,
+                         m_parameters.enteiLocation,
+                         m_parameters.latiLocation);
+    LCRNG34      rng(seed);
+    uint32_t     skipped = roamers.ConsumedFrames();
+    
+    while (skipped-- > 0)
+      rng.Next();
+    
+    for (uint32_t i = 0; i < m_numObservations; ++i)
+      key = (key * 3) + ProfElmResponses::CalcResponse(rng.Next());
+  }
+  
+  return key;
+}
+
+void Gen4ObservationIndex::FindRange
+  (uint32_t prefix, uint32_t prefixLength,
+   std::vector<uint32_t>::const_iterator &begin,
+   std::vector<uint32_t>::const_iterator &end) const
+{
+  uint32_t  span = Power(m_radix, m_numObservations - prefixLength);
+  
+  begin = m_seeds.begin() + m_keyStarts[prefix * span];
+  end = m_seeds.begin() + m_keyStarts[(prefix + 1) * span];
+}
+
+std::vector<uint32_t> Gen4ObservationIndex::FindSeeds
+  (const CoinFlips &flips) const
+{
+  std::vector<uint32_t>  result;
+  
+  if (m_parameters.observationType != CoinFlipObservations)
+    return result;
+  
+  uint32_t  numFlips = flips.NumFlips();
+  uint32_t  prefixLength = std::min(numFlips, m_numObservations);
+  uint32_t  prefix = 0;
+  
+  for (uint32_t i = 0; i < prefixLength; ++i)
+    prefix = (prefix << 1) | flips.FlipResult(i);
+  
+  std::vector<uint32_t>::const_iterator  begin, end;
+  FindRange(prefix, prefixLength, begin, end);
+  
+  if (numFlips == prefixLength)
+  {
+    result.assign(begin, end);
+  }
+  else
+  {
+    // the flips beyond the indexed ones must be checked seed by seed
+    for (; begin != end; ++begin)
+    {
+      if (CoinFlips(*begin, numFlips).Contains(flips))
+        result.push_back(*begin);
+    }
+  }
+  
+  return result;
+}
+
+std::vector<uint32_t> Gen4ObservationIndex::FindSeeds
+  (const ProfElmResponses &responses, uint32_t raikouLocation,
+   uint32_t enteiLocation, uint32_t latiLocation) const
+{
+  std::vector<uint32_t>  result;
+  
+  if (m_parameters.observationType != ProfElmObservations)
+    return result;
+  
+  uint32_t  numResponses = responses.NumResponses();
+  uint32_t  prefixLength = std::min(numResponses,
+                                    m_numObservations);
+  uint32_t  prefix = 0;
+  
+  for (uint32_t i = 0; i < prefixLength; ++i)
+    prefix = (prefix * 3) + responses.GetResponse(i);
+  
+  std::vector<uint32_t>::const_iterator  begin, end;
+  FindRange(prefix, prefixLength, begin, end);
+  
+  bool  checkRoamers =
+    (raikouLocation > 0) || (enteiLocation > 0) || (latiLocation > 0);
+  
+  if ((numResponses == prefixLength) && !checkRoamers)
+  {
+    result.assign(begin, end);
+  }
+  else
+  {
+    for (; begin != end; ++begin)
+    {
+      HGSSRoamers  roamers(*begin, m_parameters.raikouLocation,
+                           m_parameters.enteiLocation,
+                           m_parameters.latiLocation);
+      
+      if (!CheckRoamerLocation(raikouLocation,
+                               roamers.Location(HGSSRoamers::RAIKOU)) ||
+          !CheckRoamerLocation(enteiLocation,
+                               roamers.Location(HGSSRoamers::ENTEI)) ||
+          !CheckRoamerLocation(latiLocation,
+                               roamers.Location(HGSSRoamers::LATI)))
+        continue;
+      
+      if (numResponses > prefixLength)
+      {
+        LCRNG34   rng(*begin);
+        uint32_t  skipped = roamers.ConsumedFrames();
+        
+        while (skipped-- > 0)
+          rng.Next();
+        
+        if (!ProfElmResponses(rng.Seed(), numResponses).Contains(responses))
+          continue;
+      }
+      
+      result.push_back(*begin);
+    }
+  }
+  
+  return result;
+}
+
+}
@@ -0,0 +1,105 @@
+/*
+  Copyright (C) 2012 chiizu
+  chiizu.pprng@gmail.com
+  
+  This file is part of libpprng.
+  
+  libpprng is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  libpprng is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License
+  along with libpprng.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef GEN_4_OBSERVATION_INDEX_H
+#define GEN_4_OBSERVATION_INDEX_H
+
+#include "PPRNGTypes.h"
+
+#include <vector>
+
+namespace pprng
+{
+
+// Indexes every valid time seed in a delay window by the first coin flips or
+// Professor Elm responses that it produces, so that a sequence observed in
+// game can be matched against all of the seeds with a single prefix lookup.
+//
+// The observations of each seed are packed into a number with the first one
+// as its most significant digit, so the seeds starting with any prefix
+// occupy a single contiguous range of the index.
+class Gen4ObservationIndex
+{
+public:
+  enum ObservationType
+  {
+    CoinFlipObservations = 0,
+    ProfElmObservations
+  };
+  
+  enum { MaxIndexedObservations = 10 };
+  
+  struct Parameters
+  {
+    ObservationType  observationType;
+    
+    // a year adds (year - 2000) to the delay in the seed, so a span of years
+    // simply widens the window of seeds indexed
+    uint32_t         fromYear, toYear;
+    uint32_t         minDelay, maxDelay;
+    
+    // HGSS roamers move before Professor Elm's call, using up frames
+    uint32_t         raikouLocation, enteiLocation, latiLocation;
+    
+    uint32_t         numObservations;
+    
+    Parameters()
+      : observationType(CoinFlipObservations),
+        fromYear(2000), toYear(2000), minDelay(0), maxDelay(0),
+        raikouLocation(0), enteiLocation(0), latiLocation(0),
+        numObservations(MaxIndexedObservations)
+    {}
+  };
+  
+  Gen4ObservationIndex(const Parameters &parameters);
+  
+  // seeds whose flips begin with the given flips
+  std::vector<uint32_t> FindSeeds(const CoinFlips &flips) const;
+  
+  // seeds whose responses begin with the given responses, and whose roamers
+  // have moved to the given locations (0 for any location)
+  std::vector<uint32_t> FindSeeds(const ProfElmResponses &responses,
+                                  uint32_t raikouLocation = 0,
+                                  uint32_t enteiLocation = 0,
+                                  uint32_t latiLocation = 0) const;
+  
+  uint32_t NumberOfSeeds() const { return m_seeds.size(); }
+  
+private:
+  uint32_t ObservationsKey(uint32_t seed) const;
+  
+  void FindRange(uint32_t prefix, uint32_t prefixLength,
+                 std::vector<uint32_t>::const_iterator &begin,
+                 std::vector<uint32_t>::const_iterator &end) const;
+  
+  const Parameters       m_parameters;
+  const uint32_t         m_radix;
+  const uint32_t         m_numObservations;
+  
+  // seeds sorted by key, and the position of the first seed of each key
+  std::vector<uint32_t>  m_seeds;
+  std::vector<uint32_t>  m_keyStarts;
+};
+
+}
+
+#endif
@@ -28,72 +28,6 @@ namespace pprng
 namespace
 {
 
-struct SeedChecker
-{
-  SeedChecker(const Gen4QuickSeedSearcher::Criteria &criteria,
-              const Gen4QuickSeedSearcher::ResultCallback &resultHandler)
-    : m_criteria(criteria), m_resultHandler(resultHandler)
-  {}
-  
-  void operator()(const Gen34Frame &frame) const
-  {
-    uint32_t  seed = frame.rngValue;
-    uint32_t  frameNumber = 0, limit = m_criteria.frame.min - 1;
-    
-    while (frameNumber < limit)
-    {
-      seed = LCRNG34_R::NextForSeed(seed);
-      ++frameNumber;
-    }
-    
-    limit = m_criteria.frame.max;
-    while (frameNumber < limit)
-    {
-      seed = LCRNG34_R::NextForSeed(seed);
-      ++frameNumber;
-      
-      TimeSeed  ts(seed);
-      
-      if (ts.IsValid() &&
-          (ts.BaseDelay() >= m_criteria.delay.min) &&
-          (ts.BaseDelay() <= m_criteria.delay.max))
-      {
-        Gen34Frame  actualFrame = frame;
-        actualFrame.seed = seed;
-        actualFrame.number = frameNumber;
-        
-        Gen4Frame  g4Frame(actualFrame);
-        
-        Gen4Frame::EncounterData  *data;
-        
-        if ((m_criteria.version == Game::HeartGoldVersion) ||
-            (m_criteria.version == Game::SoulSilverVersion))
-        {
-          data = &g4Frame.methodK;
-        }
-        else
-        {
-          data = &g4Frame.methodJ;
-        }
-        
-        if ((data->landESVs & m_criteria.landESVs) ||
-            (data->surfESVs & m_criteria.surfESVs) ||
-            (data->oldRodESVs & m_criteria.oldRodESVs) ||
-            (data->goodRodESVs & m_criteria.goodRodESVs) ||
-            (data->superRodESVs & m_criteria.superRodESVs))
-        {
-          m_resultHandler(g4Frame);
-        }
-        
-        break;
-      }
-    }
-  }
-  
-  const Gen4QuickSeedSearcher::Criteria       &m_criteria;
-  const Gen4QuickSeedSearcher::ResultCallback &m_resultHandler;
-};
-
 struct FrameChecker
 {
   FrameChecker(const Gen4QuickSeedSearcher::Criteria &criteria)
@@ -145,12 +79,19 @@ struct FrameChecker
   const Gen4QuickSeedSearcher::Criteria  &m_criteria;
 };
 
+// Each IV seed is the RNG state at a Method 1 frame. When that frame matches,
+// the search thread walks back to the time seeds that could have led to it.
 struct SeedSearcher
 {
-  typedef Gen34Frame  ResultType;
+  typedef Gen4Frame  ResultType;
   
+  SeedSearcher(const Gen4QuickSeedSearcher::Criteria &criteria)
+    : m_criteria(criteria)
+  {}
+  
+  template <class ResultCallback>
   void Search(uint32_t seed, const FrameChecker &frameChecker,
-              const SeedChecker &resultHandler)
+              const ResultCallback &resultHandler)
   {
     Method1FrameGenerator  frameGenerator(seed);
     
@@ -158,8 +99,67 @@ struct SeedSearcher
     Gen34Frame  result = frameGenerator.CurrentFrame();
     
     if (frameChecker(result))
-      resultHandler(result);
+      FindTimeSeeds(result, resultHandler);
   }
+  
+  template <class ResultCallback>
+  void FindTimeSeeds(const Gen34Frame &frame,
+                     const ResultCallback &resultHandler) const
+  {
+    uint32_t  seed = frame.rngValue;
+    uint32_t  frameNumber = 0, limit = m_criteria.frame.min - 1;
+    
+    while (frameNumber < limit)
+    {
+      seed = LCRNG34_R::NextForSeed(seed);
+      ++frameNumber;
+    }
+    
+    limit = m_criteria.frame.max;
+    while (frameNumber < limit)
+    {
+      seed = LCRNG34_R::NextForSeed(seed);
+      ++frameNumber;
+      
+      TimeSeed  ts(seed);
+      
+      if (ts.IsValid() &&
+          (ts.BaseDelay() >= m_criteria.delay.min) &&
+          (ts.BaseDelay() <= m_criteria.delay.max))
+      {
+        Gen34Frame  actualFrame = frame;
+        actualFrame.seed = seed;
+        actualFrame.number = frameNumber;
+        
+        Gen4Frame  g4Frame(actualFrame);
+        
+        const Gen4Frame::EncounterData  *data;
+        
+        if ((m_criteria.version == Game::HeartGoldVersion) ||
+            (m_criteria.version == Game::SoulSilverVersion))
+        {
+          data = &g4Frame.GetMethodKESVs();
+        }
+        else
+        {
+          data = &g4Frame.GetMethodJESVs();
+        }
+        
+        if ((data->landESVs & m_criteria.landESVs) ||
+            (data->surfESVs & m_criteria.surfESVs) ||
+            (data->oldRodESVs & m_criteria.oldRodESVs) ||
+            (data->goodRodESVs & m_criteria.goodRodESVs) ||
+            (data->superRodESVs & m_criteria.superRodESVs))
+        {
+          resultHandler(g4Frame);
+        }
+        
+        break;
+      }
+    }
+  }
+  
+  const Gen4QuickSeedSearcher::Criteria  &m_criteria;
 };
 
 }
@@ -192,15 +192,14 @@ void Gen4QuickSeedSearcher::Search
    const SearchRunner::ProgressCallback &progressHandler)
 {
   Gen34IVSeedGenerator  seedGenerator(criteria.ivs.min, criteria.ivs.max);
-  SeedSearcher          seedSearcher;
+  SeedSearcher          seedSearcher(criteria);
   
   FrameChecker          frameChecker(criteria);
-  SeedChecker           seedChecker(criteria, resultHandler);
   
   SearchRunner          searcher;
   
-  searcher.Search(seedGenerator, seedSearcher, frameChecker,
-                  seedChecker, progressHandler);
+  searcher.SearchThreaded(seedGenerator, seedSearcher, frameChecker,
+                          resultHandler, progressHandler);
 }
 
 }
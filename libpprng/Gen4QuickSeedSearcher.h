@@ -59,7 +59,8 @@ public:
   Gen4QuickSeedSearcher() {}
   
   typedef Gen4Frame                                  ResultType;
-  typedef boost::function<void (const ResultType&)>  ResultCallback;
+  typedef boost::function<void (const ResultType*, std::size_t)>
+                                                     ResultCallback;
   
   void Search(const Criteria &criteria, const ResultCallback &resultHandler,
               const SearchRunner::ProgressCallback &progressHandler);
@@ -20,8 +20,8 @@
 
 
 #include "Gen4TIDSearcher.h"
-#include "SeedSearcher.h"
 #include "SearchCriteria.h"
+#include "MersenneTwisterRNG.h"
 
 namespace pprng
 {
@@ -29,37 +29,79 @@ namespace pprng
 namespace
 {
 
+// Checks the first frame's full 32 bit ID, SID in the upper half and TID in
+// the lower. Wanted TID and SID reduce to a masked compare, and a shiny PID
+// to the 8 TID ^ SID values in its class.
 struct FrameChecker
 {
   FrameChecker(const Gen4TIDSearcher::Criteria &criteria)
-    : m_criteria(criteria)
+    : m_idMask((criteria.considerTID ? 0x0000ffff : 0) |
+               (criteria.considerSID ? 0xffff0000 : 0)),
+      m_id(((criteria.sid << 16) | criteria.tid) & m_idMask),
+      m_considerPID(criteria.considerPID),
+      m_pidXor((criteria.pid.word >> 16) ^ (criteria.pid.word & 0xffff))
   {}
   
-  bool operator()(const Gen4TrainerIDFrame &frame) const
+  bool operator()(uint32_t fullID) const
   {
-    return (!m_criteria.considerTID || (frame.tid == m_criteria.tid)) &&
-           (!m_criteria.considerSID || (frame.sid == m_criteria.sid)) &&
-           (!m_criteria.considerPID ||
-            m_criteria.pid.IsShiny(frame.tid, frame.sid));
+    return ((fullID & m_idMask) == m_id) &&
+           (!m_considerPID ||
+            (((fullID >> 16) ^ (fullID & 0xffff) ^ m_pidXor) < 8));
   }
   
-  const Gen4TIDSearcher::Criteria  &m_criteria;
+  const uint32_t  m_idMask;
+  const uint32_t  m_id;
+  const bool      m_considerPID;
+  const uint32_t  m_pidXor;
 };
 
+// Given the rest of a time seed, works through its delays in blocks, so the
+// MT initializations for neighbouring seeds can run side by side.
 struct SeedSearcher
 {
-  void Search(const uint32_t seed, const FrameChecker &checker,
-              const Gen4TIDSearcher::ResultCallback &resultHandler)
+  typedef Gen4TrainerIDFrame  ResultType;
+  
+  enum { BlockSize = 64 };
+  
+  SeedSearcher(const Gen4TIDSearcher::Criteria &criteria)
+    : m_minDelay(criteria.minDelay), m_maxDelay(criteria.maxDelay & 0xffff)
+  {}
+  
+  template <class ResultCallback>
+  void Search(const uint32_t baseSeed, const FrameChecker &checker,
+              const ResultCallback &resultHandler)
   {
-    Gen4TrainerIDFrameGenerator  frameGen(seed);
-    frameGen.AdvanceFrame();
-    
-    // can only hit the first frame
-    Gen4TrainerIDFrame  frame = frameGen.CurrentFrame();
+    uint32_t  seeds[BlockSize], fullIDs[BlockSize];
+    uint32_t  delay = m_minDelay;
     
-    if (checker(frame))
-      resultHandler(frame);
+    while (delay <= m_maxDelay)
+    {
+      uint32_t  numSeeds = 0;
+      
+      while ((numSeeds < BlockSize) && (delay <= m_maxDelay))
+        seeds[numSeeds++] = baseSeed | delay++;
+      
+      // can only hit the first frame, which skips the first MT output
+      MTRNG::SecondOutputsForSeeds(seeds, fullIDs, numSeeds);
+      
+      for (uint32_t i = 0; i < numSeeds; ++i)
+      {
+        if (checker(fullIDs[i]))
+        {
+          Gen4TrainerIDFrame  frame;
+          
+          frame.seed = seeds[i];
+          frame.number = 1;
+          frame.tid = fullIDs[i] & 0xffff;
+          frame.sid = fullIDs[i] >> 16;
+          
+          resultHandler(frame);
+        }
+      }
+    }
   }
+  
+  const uint32_t  m_minDelay, m_maxDelay;
 };
 
 }
@@ -83,13 +125,13 @@ void Gen4TIDSearcher::Search
   (const Criteria &criteria, const ResultCallback &resultHandler,
    const SearchRunner::ProgressCallback &progressHandler)
 {
-  TimeSeedGenerator  seedGenerator(criteria.minDelay, criteria.maxDelay);
-  SeedSearcher       seedSearcher;
-  FrameChecker       frameChecker(criteria);
-  SearchRunner       searcher;
+  TimeSeedBaseGenerator  seedGenerator;
+  SeedSearcher           seedSearcher(criteria);
+  FrameChecker           frameChecker(criteria);
+  SearchRunner           searcher;
   
-  searcher.Search(seedGenerator, seedSearcher, frameChecker,
-                  resultHandler, progressHandler);
+  searcher.SearchThreaded(seedGenerator, seedSearcher, frameChecker,
+                          resultHandler, progressHandler);
 }
 
 }
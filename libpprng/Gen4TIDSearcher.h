@@ -49,7 +49,8 @@ public:
   };
   
   typedef Gen4TrainerIDFrame                         ResultType;
-  typedef boost::function<void (const ResultType&)>  ResultCallback;
+  typedef boost::function<void (const ResultType*, std::size_t)>
+                                                     ResultCallback;
   
   Gen4TIDSearcher() {}
   
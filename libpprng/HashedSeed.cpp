@@ -121,47 +121,42 @@ static uint32_t SkipPIDRNGFrames(LCRNG5 &rng, Game::Version version,
 }
 
 HashedSeed::HashedSeed(const HashedSeed::Parameters &p)
-  : parameters(p), rawSeed(HashedSeedMessage(parameters).GetRawSeed()),
-    m_skippedPIDFramesCalculated(false),
-    m_skippedPIDFramesMemoryLinkUsed(false),
-    m_skippedPIDFrames(0), m_skippedPIDFramesSeed(0)
+  : parameters(p), rawSeed(HashedSeedMessage(parameters).GetRawSeed())
 {}
 
 
-uint32_t HashedSeed::SeedAndSkipPIDFrames(LCRNG5 &rng, bool memLinkUsed) const
+HashedSeed::SkippedPIDFrames HashedSeed::CalculateSkippedPIDFrames
+  (uint64_t rawSeed, Game::Version version, bool memoryLinkUsed)
 {
-  if (!m_skippedPIDFramesCalculated ||
-      (memLinkUsed != m_skippedPIDFramesMemoryLinkUsed))
-  {
-    rng.Seed(rawSeed);
-    
-    m_skippedPIDFrames = SkipPIDRNGFrames(rng, parameters.version, memLinkUsed);
-    m_skippedPIDFramesSeed = rng.Seed();
-    
-    m_skippedPIDFramesCalculated = true;
-    m_skippedPIDFramesMemoryLinkUsed = memLinkUsed;
-  }
-  else
-  {
-    rng.Seed(m_skippedPIDFramesSeed);
-  }
+  LCRNG5            rng(rawSeed);
+  SkippedPIDFrames  result;
+  
+  result.count = SkipPIDRNGFrames(rng, version, memoryLinkUsed);
+  result.seed = rng.Seed();
   
-  return m_skippedPIDFrames;
+  return result;
 }
 
-uint32_t HashedSeed::GetSkippedPIDFrames(bool memoryLinkUsed) const
+void HashedSeed::CalculateSkippedPIDFrames
+  (const uint64_t *rawSeeds, uint32_t numSeeds, Game::Version version,
+   bool memoryLinkUsed, SkippedPIDFrames *results)
 {
-  if (!m_skippedPIDFramesCalculated ||
-      (memoryLinkUsed != m_skippedPIDFramesMemoryLinkUsed))
+  LCRNG5  rng(0);
+  
+  for (uint32_t i = 0; i < numSeeds; ++i)
   {
-    LCRNG5  rng(0);
+    rng.Seed(rawSeeds[i]);
     
-    return SeedAndSkipPIDFrames(rng, memoryLinkUsed);
-  }
-  else
-  {
-    return m_skippedPIDFrames;
+    results[i].count = SkipPIDRNGFrames(rng, version, memoryLinkUsed);
+    results[i].seed = rng.Seed();
   }
 }
 
+uint32_t HashedSeed::SeedAndSkipPIDFrames(LCRNG5 &rng, bool memLinkUsed) const
+{
+  rng.Seed(rawSeed);
+  
+  return SkipPIDRNGFrames(rng, parameters.version, memLinkUsed);
+}
+
 }
@@ -59,47 +59,59 @@ public:
   
   // to be used when raw seed is already calculated (see UnhashedSeed)
   HashedSeed(const Parameters &parameters_, uint64_t rawSeed)
-    : parameters(parameters_), rawSeed(rawSeed),
-      m_skippedPIDFramesCalculated(false),
-      m_skippedPIDFramesMemoryLinkUsed(false), m_skippedPIDFrames(0),
-      m_skippedPIDFramesSeed(0)
+    : parameters(parameters_), rawSeed(rawSeed)
   {}
   
   // to be used when only raw seed is known / important
   HashedSeed(Game::Version version, uint64_t rawSeed)
-    : parameters(version), rawSeed(rawSeed),
-      m_skippedPIDFramesCalculated(false),
-      m_skippedPIDFramesMemoryLinkUsed(false), m_skippedPIDFrames(0),
-      m_skippedPIDFramesSeed(0)
+    : parameters(version), rawSeed(rawSeed)
   {}
   
   // this is needed to decode a HashedSeed from a byte array
   HashedSeed()
-    : parameters(), rawSeed(0),
-      m_skippedPIDFramesCalculated(false),
-      m_skippedPIDFramesMemoryLinkUsed(false), m_skippedPIDFrames(0),
-      m_skippedPIDFramesSeed(0)
+    : parameters(), rawSeed(0)
   {}
   
-  const Parameters  parameters;
+  Parameters  parameters;
   
   // calculated raw seed
-  const uint64_t    rawSeed;
+  uint64_t    rawSeed;
   
   uint32_t year() const { return parameters.date.year(); }
   uint32_t month() const { return parameters.date.month(); }
   uint32_t day() const { return parameters.date.day(); }
   
-  uint32_t SeedAndSkipPIDFrames(LCRNG5 &rng, bool memoryLinkUsed) const;
+  // PID RNG frames consumed before the first usable frame
+  struct SkippedPIDFrames
+  {
+    uint32_t  count;
+    uint64_t  seed;  // LCRNG5 seed after the skipped frames
+  };
   
-  uint32_t GetSkippedPIDFrames(bool memoryLinkUsed) const;
+  // stateless, so safe to call from any thread
+  static SkippedPIDFrames CalculateSkippedPIDFrames(uint64_t rawSeed,
+                                                    Game::Version version,
+                                                    bool memoryLinkUsed);
   
-private:
-  // skipped frames calculated lazily and cached
-  mutable bool      m_skippedPIDFramesCalculated;
-  mutable bool      m_skippedPIDFramesMemoryLinkUsed;
-  mutable uint32_t  m_skippedPIDFrames;
-  mutable uint64_t  m_skippedPIDFramesSeed;
+  // batched version, results[i] corresponds to rawSeeds[i]
+  static void CalculateSkippedPIDFrames(const uint64_t *rawSeeds,
+                                        uint32_t numSeeds,
+                                        Game::Version version,
+                                        bool memoryLinkUsed,
+                                        SkippedPIDFrames *results);
+  
+  SkippedPIDFrames CalculateSkippedPIDFrames(bool memoryLinkUsed) const
+  {
+    return CalculateSkippedPIDFrames(rawSeed, parameters.version,
+                                     memoryLinkUsed);
+  }
+  
+  uint32_t SeedAndSkipPIDFrames(LCRNG5 &rng, bool memoryLinkUsed) const;
+  
+  uint32_t GetSkippedPIDFrames(bool memoryLinkUsed) const
+  {
+    return CalculateSkippedPIDFrames(memoryLinkUsed).count;
+  }
 };
 
 }
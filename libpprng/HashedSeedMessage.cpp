@@ -72,9 +72,11 @@ struct Digest
   b = a; \
   a = temp
 
-Digest SHA1(const uint32_t *message)
+// the first rounds only use the nazo words, which are fixed by the version
+// and DS type, so their result is kept with the message and reused
+void SHA1Midstate(const uint32_t *message, uint32_t midstate[])
 {
-  uint32_t  w[16], temp;
+  uint32_t  temp;
   
   uint32_t  a = H0;
   uint32_t  b = H1;
@@ -82,12 +84,35 @@ Digest SHA1(const uint32_t *message)
   uint32_t  d = H3;
   uint32_t  e = H4;
   
-  // Section 1: 0-19
-  w[0] = temp = message[0]; Section1Calc(); UpdateVars();
-  w[1] = temp = message[1]; Section1Calc(); UpdateVars();
-  w[2] = temp = message[2]; Section1Calc(); UpdateVars();
-  w[3] = temp = message[3]; Section1Calc(); UpdateVars();
-  w[4] = temp = message[4]; Section1Calc(); UpdateVars();
+  temp = message[0]; Section1Calc(); UpdateVars();
+  temp = message[1]; Section1Calc(); UpdateVars();
+  temp = message[2]; Section1Calc(); UpdateVars();
+  temp = message[3]; Section1Calc(); UpdateVars();
+  temp = message[4]; Section1Calc(); UpdateVars();
+  
+  midstate[0] = a;
+  midstate[1] = b;
+  midstate[2] = c;
+  midstate[3] = d;
+  midstate[4] = e;
+}
+
+Digest SHA1(const uint32_t *midstate, const uint32_t *message)
+{
+  uint32_t  w[16], temp;
+  
+  uint32_t  a = midstate[0];
+  uint32_t  b = midstate[1];
+  uint32_t  c = midstate[2];
+  uint32_t  d = midstate[3];
+  uint32_t  e = midstate[4];
+  
+  // Section 1: 0-19, starting after the nazo words
+  w[0] = message[0];
+  w[1] = message[1];
+  w[2] = message[2];
+  w[3] = message[3];
+  w[4] = message[4];
   w[5] = temp = message[5]; Section1Calc(); UpdateVars();
   w[6] = temp = message[6]; Section1Calc(); UpdateVars();
   w[7] = temp = message[7]; Section1Calc(); UpdateVars();
@@ -585,9 +610,9 @@ void MakeMessage(uint32_t message[], const HashedSeed::Parameters &parameters)
   message[15] = 0x000001A0; // 416
 }
 
-uint64_t CalcRawSeed(const uint32_t *message)
+uint64_t CalcRawSeed(const uint32_t *midstate, const uint32_t *message)
 {
-  Digest d = SHA1(message);
+  Digest d = SHA1(midstate, message);
   
   uint64_t  preSeed = SwapEndianess(d.h[1]);
   preSeed = (preSeed << 32) | SwapEndianess(d.h[0]);
@@ -604,6 +629,7 @@ HashedSeedMessage::HashedSeedMessage(const HashedSeed::Parameters &parameters)
     m_rawSeedCalculated(false)
 {
   MakeMessage(m_message, parameters);
+  SHA1Midstate(m_message, m_midstate);
 }
 
 HashedSeed HashedSeedMessage::AsHashedSeed() const
@@ -615,7 +641,7 @@ uint64_t HashedSeedMessage::GetRawSeed() const
 {
   if (!m_rawSeedCalculated)
   {
-    m_rawSeed = CalcRawSeed(m_message);
+    m_rawSeed = CalcRawSeed(m_midstate, m_message);
     m_rawSeedCalculated = true;
   }
   
@@ -856,6 +882,25 @@ void HashedSeedMessage::NextSecond()
   m_rawSeedCalculated = false;
 }
 
+void HashedSeedMessage::SetDateTime(const HashedSeedMessage &other)
+{
+  m_message[8] = other.m_message[8];
+  m_message[9] = other.m_message[9];
+  m_monthDays = other.m_monthDays;
+  
+  m_parameters.date = other.m_parameters.date;
+  m_parameters.hour = other.m_parameters.hour;
+  m_parameters.minute = other.m_parameters.minute;
+  m_parameters.second = other.m_parameters.second;
+  
+  // only the 3DS leaves out the PM flag
+  if ((m_parameters.dsType == DS::_3DS) !=
+      (other.m_parameters.dsType == DS::_3DS))
+    SetHour(m_parameters.hour);
+  
+  m_rawSeedCalculated = false;
+}
+
 void HashedSeedMessage::SetHeldButtons(uint32_t heldButtons)
 {
   m_parameters.heldButtons = heldButtons;
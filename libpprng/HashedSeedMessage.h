@@ -37,6 +37,8 @@ public:
   
   HashedSeed AsHashedSeed() const;
   
+  const HashedSeed::Parameters& GetParameters() const { return m_parameters; }
+  
   // calculated raw seed
   uint64_t GetRawSeed() const;
   
@@ -68,12 +70,17 @@ public:
   void SetSecond(uint32_t second);
   void NextSecond();
   
+  // copies the date and time words of another message, which need only be
+  // calculated once for any number of messages
+  void SetDateTime(const HashedSeedMessage &other);
+  
   uint32_t GetHeldButtons() const { return m_parameters.heldButtons; }
   void SetHeldButtons(uint32_t heldButtons);
   
 private:
   HashedSeed::Parameters  m_parameters;
   uint32_t                m_message[16];
+  uint32_t                m_midstate[5];  // hash state after the nazo words
   uint32_t                m_monthDays;
   
   // actual seed calculated lazily
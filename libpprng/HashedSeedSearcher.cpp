@@ -20,9 +20,12 @@
 
 
 #include "HashedSeedSearcher.h"
-#include "SeedSearcher.h"
 
 #include "IVSeedCache.h"
+#include "IncrementalSearch.h"
+
+#include <algorithm>
+#include <boost/ref.hpp>
 
 namespace pprng
 {
@@ -56,20 +59,110 @@ struct FrameChecker
   const HashedSeedSearcher::Criteria  &m_criteria;
 };
 
-struct FrameGeneratorFactory
+// Scans a seed's IV frames directly off the MT stream.  Each frame's IVs are
+// a window of 6 consecutive outputs, so the window is kept as 6 byte lanes of
+// a 64 bit word and slid along by one output per frame.  The min / max IVs are
+// compiled into the same lane layout, letting a single subtraction check all
+// 6 IVs at once; only frames inside the range are unpacked into an IVs word
+// for the hidden power check.
+class IVWindowSeedSearcher
 {
-  typedef HashedIVFrameGenerator  FrameGenerator;
+public:
+  typedef HashedIVFrame  ResultType;
   
-  FrameGeneratorFactory(HashedIVFrameGenerator::FrameType frameType)
-    : m_frameType(frameType)
+  IVWindowSeedSearcher(const HashedSeedSearcher::Criteria &criteria)
+    : m_RNG(0), m_frameRange(criteria.ivFrame),
+      m_isRoamer(criteria.ivs.isRoamer),
+      m_minLanes(PackLanes(criteria.ivs.min, criteria.ivs.isRoamer)),
+      m_maxLanes(PackLanes(criteria.ivs.max, criteria.ivs.isRoamer))
   {}
   
-  HashedIVFrameGenerator operator()(const HashedSeed &seed) const
+  template <class ResultCallback>
+  void Search(const HashedSeed &seed, const FrameChecker &frameChecker,
+              const ResultCallback &resultHandler)
   {
-    return HashedIVFrameGenerator(seed, m_frameType);
+    m_RNG.Seed(seed.rawSeed >> 32);
+    
+    if (m_isRoamer)
+      m_RNG.Next();  // unknown call
+    
+    // b2w2 skips first 2 frames
+    uint32_t  skippedOutputs = m_frameRange.min - 1 +
+      (Game::IsBlack2White2(seed.parameters.version) ? 2 : 0);
+    
+    while (skippedOutputs-- > 0)
+      m_RNG.Next();
+    
+    uint64_t  window = 0;
+    for (uint32_t i = 0; i < 5; ++i)
+      window = NextWindow(window);
+    
+    HashedIVFrame  result(seed);
+    for (uint32_t frame = m_frameRange.min; frame <= m_frameRange.max; ++frame)
+    {
+      window = NextWindow(window);
+      
+      if (InRange(window))
+      {
+        result.number = frame;
+        result.ivs = UnpackLanes(window, m_isRoamer);
+        
+        if (frameChecker.CheckHiddenPower(result.ivs))
+          resultHandler(result);
+      }
+    }
   }
   
-  const HashedIVFrameGenerator::FrameType m_frameType;
+private:
+  enum
+  {
+    LaneShift = 8,
+    NewestLaneShift = 5 * LaneShift
+  };
+  
+  static const uint64_t  GuardBits = 0x0000808080808080ULL;
+  
+  uint64_t NextWindow(uint64_t window)
+  {
+    return (window >> LaneShift) |
+           (uint64_t(m_RNG.Next() >> 27) << NewestLaneShift);
+  }
+  
+  // guard bits stop borrows crossing lanes, and survive in each lane only
+  // where min <= iv <= max
+  bool InRange(uint64_t window) const
+  {
+    return ((((window | GuardBits) - m_minLanes) &
+             ((m_maxLanes | GuardBits) - window) & GuardBits) == GuardBits);
+  }
+  
+  // normal IVs come out in the order HP, AT, DF, SA, SD, SP
+  // roamer IVs come out in the order HP, AT, DF, SD, SP, SA
+  static uint64_t PackLanes(IVs ivs, bool isRoamer)
+  {
+    return uint64_t(ivs.hp()) |
+           (uint64_t(ivs.at()) << LaneShift) |
+           (uint64_t(ivs.df()) << (2 * LaneShift)) |
+           (uint64_t(isRoamer ? ivs.sd() : ivs.sa()) << (3 * LaneShift)) |
+           (uint64_t(isRoamer ? ivs.sp() : ivs.sd()) << (4 * LaneShift)) |
+           (uint64_t(isRoamer ? ivs.sa() : ivs.sp()) << (5 * LaneShift));
+  }
+  
+  static IVs UnpackLanes(uint64_t window, bool isRoamer)
+  {
+    uint32_t  lane[6];
+    for (uint32_t i = 0; i < 6; ++i)
+      lane[i] = (window >> (i * LaneShift)) & IVs::IV_MASK;
+    
+    return isRoamer ?
+      IVs(lane[0], lane[1], lane[2], lane[5], lane[3], lane[4]) :
+      IVs(lane[0], lane[1], lane[2], lane[3], lane[4], lane[5]);
+  }
+  
+  MTRNG                             m_RNG;
+  const SearchCriteria::FrameRange  &m_frameRange;
+  const bool                        m_isRoamer;
+  const uint64_t                    m_minLanes, m_maxLanes;
 };
 
 struct SeedHashSearcher
@@ -83,8 +176,9 @@ struct SeedHashSearcher
       m_frameOffset(isBlack2White2 ? 2 : 0)
   {}
   
+  template <class ResultCallback>
   void Search(const HashedSeed &seed, const FrameChecker &frameChecker,
-              const HashedSeedSearcher::ResultCallback &resultHandler)
+              const ResultCallback &resultHandler)
   {
     uint32_t  ivSeed = seed.rawSeed >> 32;
     
@@ -129,8 +223,9 @@ struct SeedMapSearcher
       m_frameOffset(isBlack2White2 ? 2 : 0)
   {}
   
+  template <class ResultCallback>
   void Search(const HashedSeed &seed, const FrameChecker &frameChecker,
-              const HashedSeedSearcher::ResultCallback &resultHandler)
+              const ResultCallback &resultHandler)
   {
     uint32_t  ivSeed = seed.rawSeed >> 32;
     uint32_t  limit = m_frameRange.min + m_frameOffset;
@@ -178,52 +273,488 @@ uint64_t HashedSeedSearcher::Criteria::ExpectedNumberOfResults() const
   return numResults;
 }
 
+namespace
+{
+
+// rough per seed costs, in nanoseconds
+enum
+{
+  SeedHashingCost = 300,      // SHA-1 of the seed message
+  MTSeedingCost = 900,        // seeding the MT
+  MTOutputCost = 5,           // each MT output scanned
+  HashLookupCost = 20,        // unordered_map find
+  MapLookupStepCost = 3,      // each step of the map's binary search
+  CachedFrameCost = 10        // each cached frame examined and filtered
+};
+
+static uint32_t Log2(std::size_t n)
+{
+  uint32_t  result = 0;
+  
+  while (n > 1)
+  {
+    n >>= 1;
+    ++result;
+  }
+  
+  return result;
+}
+
+}
+
+HashedSeedSearcher::Plan HashedSeedSearcher::PlanSearch
+  (const Criteria &criteria)
+{
+  bool      isRoamer = criteria.ivs.isRoamer;
+  uint32_t  offset =
+    Game::IsBlack2White2(criteria.seedParameters.version) ? 2 : 0;
+  uint32_t  numFrames = criteria.ivFrame.max - criteria.ivFrame.min + 1;
+  uint64_t  numSeeds = criteria.seedParameters.NumberOfSeeds();
+  
+  Plan  result;
+  
+  // scanning always works, skipping to the first frame then sliding a window
+  // of 6 outputs along
+  uint64_t  perSeedCost = MTSeedingCost +
+    (MTOutputCost * ((isRoamer ? 1 : 0) + offset + criteria.ivFrame.min - 1 +
+                     5 + numFrames));
+  
+  // any cached pattern covering the criteria can be searched instead, the
+  // smaller the better
+  IVPattern::Type  patterns[] =
+    { IVPattern::HEX_FLAWLESS, IVPattern::PHYSICAL_FLAWLESS,
+      IVPattern::SPECIAL_FLAWLESS, IVPattern::SPECIAL_HIDDEN_POWER_FLAWLESS,
+      IVPattern::HEX_FLAWLESS_TRICK, IVPattern::PHYSICAL_FLAWLESS_TRICK,
+      IVPattern::SPECIAL_FLAWLESS_TRICK,
+      IVPattern::SPECIAL_HIDDEN_POWER_FLAWLESS_TRICK };
+  
+  for (uint32_t i = 0; i < (sizeof(patterns) / sizeof(patterns[0])); ++i)
+  {
+    IVPattern::Type  pattern = patterns[i];
+    
+    if (!IVSeedCacheCovers(pattern, criteria.ivs.min, criteria.ivs.max,
+                           criteria.ivs.hiddenTypeMask,
+                           criteria.ivs.minHiddenPower))
+      continue;
+    
+    if ((criteria.ivFrame.max + offset) <= IVSeedHashMaxFrameFor(isRoamer))
+    {
+      const IVSeedHash  &seedHash = GetIVSeedHash(pattern, isRoamer);
+      
+      // each entry holds all the cached frames of its seed
+      uint64_t  cost = HashLookupCost +
+        ((uint64_t(CachedFrameCost) * IVSeedHashMaxFrameFor(isRoamer) *
+          seedHash.size()) >> 32);
+      
+      if (cost < perSeedCost)
+      {
+        perSeedCost = cost;
+        result.strategy = LookUpIVSeedHash;
+        result.cachePattern = pattern;
+      }
+    }
+    
+    if ((criteria.ivFrame.max + offset) <= IVSeedMapMaxFrameFor(isRoamer))
+    {
+      const IVSeedMap  &seedMap = GetIVSeedMap(pattern, isRoamer);
+      
+      uint64_t  cost = (MapLookupStepCost * 2 * Log2(seedMap.size())) +
+        ((uint64_t(CachedFrameCost) * seedMap.size()) >> 32);
+      
+      if (cost < perSeedCost)
+      {
+        perSeedCost = cost;
+        result.strategy = LookUpIVSeedMap;
+        result.cachePattern = pattern;
+      }
+    }
+  }
+  
+  result.estimatedCost = numSeeds * (SeedHashingCost + perSeedCost);
+  
+  return result;
+}
+
+namespace
+{
+
+// runs the planned search over any generator of hashed seeds
+template <class SeedGenerator, class ResultCallback>
+void SearchSeeds(SeedGenerator &seedGenerator,
+                 const HashedSeedSearcher::Criteria &criteria,
+                 const HashedSeedSearcher::Plan &plan,
+                 ResultCallback &resultHandler,
+                 const SearchRunner::ProgressCallback &progressHandler)
+{
+  FrameChecker  frameChecker(criteria);
+  SearchRunner  searcher;
+  
+  bool  isRoamer = criteria.ivs.isRoamer;
+  bool  isBlack2White2 = Game::IsBlack2White2(criteria.seedParameters.version);
+  
+  switch (plan.strategy)
+  {
+  case HashedSeedSearcher::LookUpIVSeedHash:
+    {
+      SeedHashSearcher  seedSearcher(GetIVSeedHash(plan.cachePattern,
+                                                   isRoamer),
+                                     criteria.ivFrame,
+                                     isBlack2White2);
+      searcher.SearchThreaded(seedGenerator, seedSearcher, frameChecker,
+                              resultHandler, progressHandler);
+    }
+    break;
+    
+  case HashedSeedSearcher::LookUpIVSeedMap:
+    {
+      SeedMapSearcher  seedSearcher(GetIVSeedMap(plan.cachePattern, isRoamer),
+                                    criteria.ivFrame,
+                                    isBlack2White2);
+      searcher.SearchThreaded(seedGenerator, seedSearcher, frameChecker,
+                              resultHandler, progressHandler);
+    }
+    break;
+    
+  case HashedSeedSearcher::ScanIVFrames:
+  default:
+    {
+      IVWindowSeedSearcher  seedSearcher(criteria);
+      
+      searcher.SearchThreaded(seedGenerator, seedSearcher, frameChecker,
+                              resultHandler, progressHandler);
+    }
+    break;
+  }
+}
+
+}
+
 void HashedSeedSearcher::Search
   (const Criteria &criteria, const ResultCallback &resultHandler,
    const SearchRunner::ProgressCallback &progressHandler)
 {
   HashedSeedGenerator  seedGenerator(criteria.seedParameters);
-  FrameChecker         frameChecker(criteria);
-  SearchRunner         searcher;
   
-  IVPattern::Type  ivPattern = criteria.ivs.GetPattern();
-  bool             isBlack2White2 =
-    Game::IsBlack2White2(criteria.seedParameters.version);
-  uint32_t         offset = isBlack2White2 ? 2 :0;
+  SearchSeeds(seedGenerator, criteria, PlanSearch(criteria),
+              resultHandler, progressHandler);
+}
+
+
+namespace
+{
+
+typedef HashedSeedGenerator::Parameters  SeedParameters;
+
+bool IVCriteriaCovers(const SearchCriteria::IVCriteria &outer,
+                      const SearchCriteria::IVCriteria &inner)
+{
+  return (outer.isRoamer == inner.isRoamer) &&
+         inner.min.betterThanOrEqual(outer.min) &&
+         inner.max.worseThanOrEqual(outer.max) &&
+         ((outer.hiddenTypeMask == 0) ||
+          ((inner.hiddenTypeMask != 0) &&
+           ((inner.hiddenTypeMask & ~outer.hiddenTypeMask) == 0) &&
+           (inner.minHiddenPower >= outer.minHiddenPower)));
+}
+
+bool ResultMatches(const HashedSeedSearcher::Criteria &criteria,
+                   const HashedIVFrame &frame)
+{
+  return SeedParametersHold(criteria.seedParameters, frame.seed.parameters) &&
+         (frame.number >= criteria.ivFrame.min) &&
+         (frame.number <= criteria.ivFrame.max) &&
+         FrameChecker(criteria)(frame);
+}
+
+// the parts of a number range in wider but not in narrower
+void AddRangeDifference(uint32_t wideLow, uint32_t wideHigh,
+                        uint32_t narrowLow, uint32_t narrowHigh,
+                        uint32_t SeedParameters::*low,
+                        uint32_t SeedParameters::*high,
+                        const SeedParameters &parameters,
+                        std::vector<SeedParameters> &result)
+{
+  SeedParameters  part = parameters;
   
-  if ((ivPattern == IVPattern::CUSTOM) ||
-      (criteria.ivFrame.min > (IVSeedMapMaxFrame - offset)) ||
-      (criteria.ivFrame.max > (IVSeedMapMaxFrame - offset)) ||
-      (criteria.ivs.isRoamer && isBlack2White2))
+  if (wideLow < narrowLow)
   {
-    FrameGeneratorFactory  frameGenFactory(criteria.ivs.isRoamer ?
-                                         HashedIVFrameGenerator::Roamer :
-                                         HashedIVFrameGenerator::Normal);
+    part.*low = wideLow;
+    part.*high = std::min(wideHigh, narrowLow - 1);
+    result.push_back(part);
+  }
+  if (wideHigh > narrowHigh)
+  {
+    part.*low = std::max(wideLow, narrowHigh + 1);
+    part.*high = wideHigh;
+    result.push_back(part);
+  }
+}
+
+// The seeds in searched but not in covered, when they differ in at most one
+// of their ranges.  Returns false if they differ in more, or their DS does.
+bool SeedParametersDifference(const SeedParameters &covered,
+                              const SeedParameters &searched,
+                              std::vector<SeedParameters> &result)
+{
+  if ((covered.version != searched.version) ||
+      (covered.dsType != searched.dsType) ||
+      (covered.macAddress != searched.macAddress))
+    return false;
+  
+  bool  timesCovered = (searched.fromTime >= covered.fromTime) &&
+                       (searched.toTime <= covered.toTime);
+  bool  timer0Covered = (searched.timer0Low >= covered.timer0Low) &&
+                        (searched.timer0High <= covered.timer0High);
+  bool  vcountCovered = (searched.vcountLow >= covered.vcountLow) &&
+                        (searched.vcountHigh <= covered.vcountHigh);
+  bool  vframeCovered = (searched.vframeLow >= covered.vframeLow) &&
+                        (searched.vframeHigh <= covered.vframeHigh);
+  bool  buttonsCovered = ButtonsCover(covered.heldButtons,
+                                      searched.heldButtons);
   
-    SeedFrameSearcher<FrameGeneratorFactory>  seedSearcher(frameGenFactory,
-                                                           criteria.ivFrame);
+  uint32_t  uncovered = !timesCovered + !timer0Covered + !vcountCovered +
+                        !vframeCovered + !buttonsCovered;
+  
+  if (uncovered > 1)
+    return false;
+  
+  if (!timesCovered)
+  {
+    using namespace boost::posix_time;
     
-    searcher.SearchThreaded(seedGenerator, seedSearcher, frameChecker,
-                            resultHandler, progressHandler);
+    SeedParameters  part = searched;
+    
+    if (searched.fromTime < covered.fromTime)
+    {
+      part.toTime = std::min(searched.toTime, covered.fromTime - seconds(1));
+      result.push_back(part);
+    }
+    if (searched.toTime > covered.toTime)
+    {
+      part.fromTime = std::max(searched.fromTime,
+                               covered.toTime + seconds(1));
+      part.toTime = searched.toTime;
+      result.push_back(part);
+    }
+  }
+  else if (!timer0Covered)
+  {
+    AddRangeDifference(searched.timer0Low, searched.timer0High,
+                       covered.timer0Low, covered.timer0High,
+                       &SeedParameters::timer0Low, &SeedParameters::timer0High,
+                       searched, result);
   }
-  else if ((criteria.ivFrame.min > (IVSeedHashMaxFrame - offset)) ||
-           (criteria.ivFrame.max > (IVSeedHashMaxFrame - offset)))
+  else if (!vcountCovered)
   {
-    SeedMapSearcher  seedSearcher(GetIVSeedMap(ivPattern),
-                                  criteria.ivFrame,
-                                  isBlack2White2);
-    searcher.SearchThreaded(seedGenerator, seedSearcher, frameChecker,
-                            resultHandler, progressHandler);
+    AddRangeDifference(searched.vcountLow, searched.vcountHigh,
+                       covered.vcountLow, covered.vcountHigh,
+                       &SeedParameters::vcountLow, &SeedParameters::vcountHigh,
+                       searched, result);
+  }
+  else if (!vframeCovered)
+  {
+    AddRangeDifference(searched.vframeLow, searched.vframeHigh,
+                       covered.vframeLow, covered.vframeHigh,
+                       &SeedParameters::vframeLow, &SeedParameters::vframeHigh,
+                       searched, result);
+  }
+  else if (!buttonsCovered)
+  {
+    SeedParameters  part = searched;
+    
+    part.heldButtons.clear();
+    
+    Button::List::const_iterator  i;
+    for (i = searched.heldButtons.begin(); i != searched.heldButtons.end(); ++i)
+    {
+      if (!HasButtons(covered.heldButtons, *i))
+        part.heldButtons.push_back(*i);
+    }
+    
+    result.push_back(part);
+  }
+  
+  return true;
+}
+
+}
+
+void IncrementalHashedSeedSearcher::Search
+  (const Criteria &criteria, const ResultCallback &resultHandler,
+   const SearchRunner::ProgressCallback &progressHandler)
+{
+  std::vector<SeedParameters>  parts;
+  std::vector<ResultType>      results;
+  
+  if (m_hasResults &&
+      IVCriteriaCovers(m_criteria.ivs, criteria.ivs) &&
+      (criteria.ivFrame.min >= m_criteria.ivFrame.min) &&
+      (criteria.ivFrame.max <= m_criteria.ivFrame.max) &&
+      SeedParametersDifference(m_criteria.seedParameters,
+                               criteria.seedParameters, parts))
+  {
+    std::vector<ResultType>::const_iterator  i;
+    for (i = m_results.begin(); i != m_results.end(); ++i)
+    {
+      if (ResultMatches(criteria, *i))
+        results.push_back(*i);
+    }
+    
+    if (!results.empty())
+      resultHandler(&results[0], results.size());
   }
   else
   {
-    SeedHashSearcher  seedSearcher(GetIVSeedHash(ivPattern,
-                                                 criteria.ivs.isRoamer),
-                                   criteria.ivFrame,
-                                   isBlack2White2);
-    searcher.SearchThreaded(seedGenerator, seedSearcher, frameChecker,
-                            resultHandler, progressHandler);
+    parts.push_back(criteria.seedParameters);
   }
+  
+  // the stored results are incomplete until the search finishes
+  m_hasResults = false;
+  
+  uint64_t  numSeeds = 0;
+  std::vector<SeedParameters>::const_iterator  p;
+  for (p = parts.begin(); p != parts.end(); ++p)
+    numSeeds += p->NumberOfSeeds();
+  
+  if (numSeeds == 0)
+    progressHandler(100.0);
+  
+  StoringResultHandler<ResultType>  storingResultHandler(results,
+                                                         resultHandler);
+  PartProgressHandler               partProgressHandler(progressHandler);
+  HashedSeedSearcher                searcher;
+  Criteria                          partCriteria = criteria;
+  
+  for (p = parts.begin();
+       (p != parts.end()) && !partProgressHandler.m_cancelled;
+       ++p)
+  {
+    partCriteria.seedParameters = *p;
+    partProgressHandler.m_share = double(p->NumberOfSeeds()) / numSeeds;
+    
+    searcher.Search(partCriteria, storingResultHandler,
+                    boost::ref(partProgressHandler));
+  }
+  
+  if (!partProgressHandler.m_cancelled)
+  {
+    m_criteria = criteria;
+    m_results.swap(results);
+    m_hasResults = true;
+  }
+}
+
+void IncrementalHashedSeedSearcher::Reset()
+{
+  m_hasResults = false;
+  m_criteria = Criteria();
+  m_results.clear();
+}
+
+
+
+namespace
+{
+
+HashedSeedSearcher::Criteria ProfileCriteria
+  (const MultiProfileHashedSeedSearcher::Criteria &criteria,
+   const SeedParameters &profile)
+{
+  HashedSeedSearcher::Criteria  result;
+  
+  result.seedParameters = profile;
+  result.ivs = criteria.ivs;
+  result.ivFrame = criteria.ivFrame;
+  
+  return result;
+}
+
+struct ProfileTaggingResultHandler
+{
+  typedef MultiProfileHashedSeedSearcher::ResultType  ResultType;
+  
+  ProfileTaggingResultHandler
+    (const std::vector<SeedParameters> &profiles,
+     const MultiProfileHashedSeedSearcher::ResultCallback &resultHandler)
+    : m_profiles(profiles), m_resultHandler(resultHandler)
+  {}
+  
+  void operator()(const HashedIVFrame *frames, std::size_t numFrames) const
+  {
+    std::vector<ResultType>  results;
+    results.reserve(numFrames);
+    
+    for (std::size_t i = 0; i < numFrames; ++i)
+    {
+      const HashedSeed::Parameters  &seed = frames[i].seed.parameters;
+      
+      uint32_t  profile = 0;
+      while ((profile < (m_profiles.size() - 1)) &&
+             !SeedParametersHold(m_profiles[profile], seed))
+        ++profile;
+      
+      results.push_back(ResultType(frames[i], profile));
+    }
+    
+    m_resultHandler(&results[0], results.size());
+  }
+  
+  const std::vector<SeedParameters>                     &m_profiles;
+  const MultiProfileHashedSeedSearcher::ResultCallback  &m_resultHandler;
+};
+
+}
+
+uint64_t MultiProfileHashedSeedSearcher::Criteria::ExpectedNumberOfResults()
+  const
+{
+  uint64_t  result = 0;
+  
+  std::vector<SeedParameters>::const_iterator  i;
+  for (i = seedParameters.begin(); i != seedParameters.end(); ++i)
+    result += ProfileCriteria(*this, *i).ExpectedNumberOfResults();
+  
+  return result;
+}
+
+void MultiProfileHashedSeedSearcher::Search
+  (const Criteria &criteria, const ResultCallback &resultHandler,
+   const SearchRunner::ProgressCallback &progressHandler)
+{
+  if (criteria.seedParameters.empty())
+  {
+    progressHandler(100.0);
+    return;
+  }
+  
+  // The cached IV lookups skip a fixed number of frames, so they can only
+  // be used when the profiles are all BW or all B2W2, and then only if they
+  // suit every profile.
+  HashedSeedSearcher::Criteria  planCriteria =
+    ProfileCriteria(criteria, criteria.seedParameters.front());
+  HashedSeedSearcher::Plan      plan =
+    HashedSeedSearcher::PlanSearch(planCriteria);
+  
+  std::vector<SeedParameters>::const_iterator  i;
+  for (i = criteria.seedParameters.begin();
+       i != criteria.seedParameters.end();
+       ++i)
+  {
+    if (Game::IsBlack2White2(i->version) !=
+        Game::IsBlack2White2(planCriteria.seedParameters.version))
+    {
+      plan.strategy = HashedSeedSearcher::ScanIVFrames;
+      plan.cachePattern = IVPattern::CUSTOM;
+      break;
+    }
+  }
+  
+  MultiProfileHashedSeedGenerator  seedGenerator(criteria.seedParameters);
+  ProfileTaggingResultHandler      taggingResultHandler(criteria.seedParameters,
+                                                        resultHandler);
+  
+  SearchSeeds(seedGenerator, planCriteria, plan,
+              taggingResultHandler, progressHandler);
 }
 
 }
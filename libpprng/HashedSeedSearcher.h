@@ -28,6 +28,7 @@
 #include "SeedGenerator.h"
 #include "FrameGenerator.h"
 
+#include <vector>
 #include <boost/function.hpp>
 
 namespace pprng
@@ -49,8 +50,37 @@ public:
     uint64_t ExpectedNumberOfResults() const;
   };
   
+  // how the IVs of each seed are found
+  enum Strategy
+  {
+    ScanIVFrames = 0,   // generate each seed's IV frames
+    LookUpIVSeedMap,    // look the seed up in a cached pattern's map
+    LookUpIVSeedHash    // look the seed up in a cached pattern's hash
+  };
+  
+  struct Plan
+  {
+    Strategy         strategy;
+    
+    // the cached pattern searched, whose results are then filtered by the
+    // criteria, or CUSTOM when scanning
+    IVPattern::Type  cachePattern;
+    
+    // estimated time for the whole search, in nanoseconds
+    uint64_t         estimatedCost;
+    
+    Plan()
+      : strategy(ScanIVFrames), cachePattern(IVPattern::CUSTOM),
+        estimatedCost(0)
+    {}
+  };
+  
+  // the cheapest way to search for the criteria, as used by Search
+  static Plan PlanSearch(const Criteria &criteria);
+  
   typedef HashedIVFrameGenerator::Frame              ResultType;
-  typedef boost::function<void (const ResultType&)>  ResultCallback;
+  typedef boost::function<void (const ResultType*, std::size_t)>
+                                                     ResultCallback;
   
   HashedSeedSearcher() {}
   
@@ -58,6 +88,71 @@ public:
               const SearchRunner::ProgressCallback &progressHandler);
 };
 
+// Keeps the criteria and results of its last search.  A following search on
+// the same DS whose IV criteria are the same or narrower is answered by
+// filtering those results, plus a search of only the seeds it adds if its
+// seed parameters are wider in just one of the times, timer0, vcount, vframe
+// or held buttons.  Anything else is searched in full.
+class IncrementalHashedSeedSearcher
+{
+public:
+  typedef HashedSeedSearcher::Criteria        Criteria;
+  typedef HashedSeedSearcher::ResultType      ResultType;
+  typedef HashedSeedSearcher::ResultCallback  ResultCallback;
+  
+  IncrementalHashedSeedSearcher()
+    : m_hasResults(false), m_criteria(), m_results()
+  {}
+  
+  void Search(const Criteria &criteria, const ResultCallback &resultHandler,
+              const SearchRunner::ProgressCallback &progressHandler);
+  
+  // forgets the last search
+  void Reset();
+  
+private:
+  bool                     m_hasResults;
+  Criteria                 m_criteria;
+  std::vector<ResultType>  m_results;
+};
+
+// Searches several sets of seed parameters, such as those of different DSs
+// or games, in one threaded run.  Each result is tagged with the index of the
+// first set of parameters holding its seed.
+class MultiProfileHashedSeedSearcher
+{
+public:
+  struct Criteria : public SearchCriteria
+  {
+    MultiProfileHashedSeedGenerator::ProfileList  seedParameters;
+    SearchCriteria::IVCriteria                    ivs;
+    SearchCriteria::FrameRange                    ivFrame;
+    
+    Criteria()
+      : SearchCriteria(), seedParameters(), ivs(), ivFrame()
+    {}
+    
+    uint64_t ExpectedNumberOfResults() const;
+  };
+  
+  struct ResultType : public HashedIVFrame
+  {
+    ResultType(const HashedIVFrame &frame, uint32_t profile_)
+      : HashedIVFrame(frame), profile(profile_)
+    {}
+    
+    uint32_t  profile;  // index into Criteria::seedParameters
+  };
+  
+  typedef boost::function<void (const ResultType*, std::size_t)>
+                                                     ResultCallback;
+  
+  MultiProfileHashedSeedSearcher() {}
+  
+  void Search(const Criteria &criteria, const ResultCallback &resultHandler,
+              const SearchRunner::ProgressCallback &progressHandler);
+};
+
 }
 
 #endif
@@ -0,0 +1,364 @@
+/*
+  Copyright (C) 2012 chiizu
+  chiizu.pprng@gmail.com
+  
+  This file is part of libpprng.
+  
+  libpprng is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  libpprng is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License
+  along with libpprng.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "HashedSeedTable.h"
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+#include <cstdio>
+#include <string.h>
+
+#include <boost/thread.hpp>
+#include <boost/interprocess/exceptions.hpp>
+
+namespace pprng
+{
+
+namespace
+{
+
+// the file is all 64 bit words: the header, the profile and times the table
+// covers, then the raw seeds
+static const char      s_TableFileHeader[] = "SEED_HASH_TABLE";
+static const uint64_t  s_TableFileVersion = 0x0100;
+
+static const boost::posix_time::ptime
+  s_TableEpoch(boost::gregorian::date(2000, 1, 1));
+
+enum
+{
+  HeaderWords = sizeof(s_TableFileHeader) / sizeof(uint64_t),
+  ProfileWords = 13  // plus the held buttons
+};
+
+static const char  s_TableFileName[] = "seedtable.dat";
+
+static std::string                               s_TableDirectory;
+static boost::shared_ptr<const HashedSeedTable>  s_Table;
+static boost::mutex                              s_TableMutex;
+
+void AppendProfileWords(const HashedSeedGenerator::Parameters &parameters,
+                        std::vector<uint64_t> &words)
+{
+  words.push_back(s_TableFileVersion);
+  words.push_back(parameters.version);
+  words.push_back(parameters.dsType);
+  words.push_back(parameters.macAddress);
+  words.push_back(parameters.timer0Low);
+  words.push_back(parameters.timer0High);
+  words.push_back(parameters.vcountLow);
+  words.push_back(parameters.vcountHigh);
+  words.push_back(parameters.vframeLow);
+  words.push_back(parameters.vframeHigh);
+  words.push_back((parameters.fromTime - s_TableEpoch).total_seconds());
+  words.push_back((parameters.toTime - s_TableEpoch).total_seconds());
+  words.push_back(parameters.heldButtons.size());
+  
+  words.insert(words.end(), parameters.heldButtons.begin(),
+               parameters.heldButtons.end());
+}
+
+uint64_t SeedsPerSecond(const HashedSeedGenerator::Parameters &parameters)
+{
+  return uint64_t(parameters.heldButtons.size()) *
+         (parameters.timer0High - parameters.timer0Low + 1) *
+         (parameters.vcountHigh - parameters.vcountLow + 1) *
+         (parameters.vframeHigh - parameters.vframeLow + 1);
+}
+
+bool HasNoSeeds(const HashedSeedGenerator::Parameters &parameters)
+{
+  return parameters.heldButtons.empty() ||
+         (parameters.timer0Low > parameters.timer0High) ||
+         (parameters.vcountLow > parameters.vcountHigh) ||
+         (parameters.vframeLow > parameters.vframeHigh) ||
+         (parameters.fromTime > parameters.toTime);
+}
+
+bool SameProfile(const HashedSeedGenerator::Parameters &a,
+                 const HashedSeedGenerator::Parameters &b)
+{
+  return (a.version == b.version) && (a.dsType == b.dsType) &&
+         (a.macAddress == b.macAddress) &&
+         (a.timer0Low == b.timer0Low) && (a.timer0High == b.timer0High) &&
+         (a.vcountLow == b.vcountLow) && (a.vcountHigh == b.vcountHigh) &&
+         (a.vframeLow == b.vframeLow) && (a.vframeHigh == b.vframeHigh) &&
+         (a.heldButtons == b.heldButtons);
+}
+
+// stores each seed's raw seed at its place in the table, finding nothing
+struct TableSeedSearcher
+{
+  typedef HashedSeed  ResultType;
+  
+  TableSeedSearcher(const HashedSeedGenerator::Parameters &parameters,
+                    uint64_t *rawSeeds)
+    : m_parameters(parameters), m_rawSeeds(rawSeeds)
+  {}
+  
+  template <class ResultChecker, class ResultCallback>
+  void Search(const HashedSeed &seed, const ResultChecker&,
+              const ResultCallback&)
+  {
+    m_rawSeeds[SeedIndex(seed.parameters)] = seed.rawSeed;
+  }
+  
+  // the inverse of HashedSeedGenerator's ordering
+  uint64_t SeedIndex(const HashedSeed::Parameters &seed) const
+  {
+    using namespace boost::posix_time;
+    
+    ptime     time(seed.date, hours(seed.hour) + minutes(seed.minute) +
+                              seconds(seed.second));
+    uint64_t  index = (time - m_parameters.fromTime).total_seconds();
+    
+    index = (index * (m_parameters.vframeHigh - m_parameters.vframeLow + 1)) +
+            (seed.vframe - m_parameters.vframeLow);
+    index = (index * (m_parameters.vcountHigh - m_parameters.vcountLow + 1)) +
+            (seed.vcount - m_parameters.vcountLow);
+    index = (index * (m_parameters.timer0High - m_parameters.timer0Low + 1)) +
+            (seed.timer0 - m_parameters.timer0Low);
+    index = (index * m_parameters.heldButtons.size()) +
+            (std::find(m_parameters.heldButtons.begin(),
+                       m_parameters.heldButtons.end(), seed.heldButtons) -
+             m_parameters.heldButtons.begin());
+    
+    return index;
+  }
+  
+  const HashedSeedGenerator::Parameters  &m_parameters;
+  uint64_t                               *m_rawSeeds;
+};
+
+struct NoResultChecker {};
+
+struct NoResultHandler
+{
+  void operator()(const HashedSeed*, std::size_t) {}
+};
+
+struct WriteProgressHandler
+{
+  WriteProgressHandler(const SearchRunner::ProgressCallback &progressHandler)
+    : m_progressHandler(progressHandler), m_cancelled(false)
+  {}
+  
+  bool operator()(double progress)
+  {
+    m_cancelled = m_cancelled || !m_progressHandler(progress);
+    
+    return !m_cancelled;
+  }
+  
+  const SearchRunner::ProgressCallback  &m_progressHandler;
+  bool                                  m_cancelled;
+};
+
+}
+
+HashedSeedTable::HashedSeedTable(const std::string &filePath)
+  : m_file(filePath.c_str(), boost::interprocess::read_only),
+    m_region(m_file, boost::interprocess::read_only),
+    m_parameters(), m_seedsPerSecond(0), m_rawSeeds(0)
+{
+  const uint64_t  *words = static_cast<const uint64_t*>(m_region.get_address());
+  uint64_t        numWords = m_region.get_size() / sizeof(uint64_t);
+  
+  if ((numWords < (HeaderWords + ProfileWords)) ||
+      (memcmp(words, s_TableFileHeader, sizeof(s_TableFileHeader)) != 0))
+    return;
+  
+  const uint64_t  *profile = words + HeaderWords;
+  
+  if (profile[0] != s_TableFileVersion)
+    return;
+  
+  m_parameters.version = Game::Version(profile[1]);
+  m_parameters.dsType = DS::Type(profile[2]);
+  m_parameters.macAddress = profile[3];
+  m_parameters.timer0Low = profile[4];
+  m_parameters.timer0High = profile[5];
+  m_parameters.vcountLow = profile[6];
+  m_parameters.vcountHigh = profile[7];
+  m_parameters.vframeLow = profile[8];
+  m_parameters.vframeHigh = profile[9];
+  m_parameters.fromTime =
+    s_TableEpoch + boost::posix_time::seconds(long(profile[10]));
+  m_parameters.toTime =
+    s_TableEpoch + boost::posix_time::seconds(long(profile[11]));
+  
+  uint64_t  numButtons = profile[12];
+  uint64_t  seedsStart = HeaderWords + ProfileWords + numButtons;
+  
+  if (numWords < seedsStart)
+    return;
+  
+  m_parameters.heldButtons.assign(profile + ProfileWords,
+                                  profile + ProfileWords + numButtons);
+  
+  if (HasNoSeeds(m_parameters) ||
+      ((numWords - seedsStart) != m_parameters.NumberOfSeeds()))
+    return;
+  
+  m_seedsPerSecond = SeedsPerSecond(m_parameters);
+  m_rawSeeds = words + seedsStart;
+}
+
+void HashedSeedTable::SetTableDirectory(const std::string &dir)
+{
+  s_TableDirectory = dir;
+}
+
+std::string HashedSeedTable::TableFilePath()
+{
+  std::string  filePath = s_TableDirectory;
+  if (!filePath.empty())
+  {
+    filePath += '/';
+  }
+  filePath += s_TableFileName;
+  
+  return filePath;
+}
+
+bool HashedSeedTable::Write
+  (const HashedSeedGenerator::Parameters &parameters,
+   const std::string &filePath,
+   const SearchRunner::ProgressCallback &progressHandler)
+{
+  using namespace boost::interprocess;
+  
+  if (HasNoSeeds(parameters))
+    return false;
+  
+  // filePath may be mapped by a running search, so it is only ever renamed
+  // over, never truncated
+  std::string  tempFilePath = filePath + ".tmp";
+  
+  std::vector<uint64_t>  words(HeaderWords);
+  memcpy(&words[0], s_TableFileHeader, sizeof(s_TableFileHeader));
+  AppendProfileWords(parameters, words);
+  
+  uint64_t  headerSize = words.size() * sizeof(uint64_t);
+  uint64_t  fileSize = headerSize +
+                       (parameters.NumberOfSeeds() * sizeof(uint64_t));
+  
+  {
+    std::ofstream  out(tempFilePath.c_str(), std::ios::out | std::ios::binary);
+    
+    out.write(reinterpret_cast<const char*>(&words[0]), headerSize);
+    out.seekp(fileSize - 1);
+    out.put(0);
+    
+    if (!out)
+    {
+      out.close();
+      std::remove(tempFilePath.c_str());
+      return false;
+    }
+  }
+  
+  WriteProgressHandler  writeProgressHandler(progressHandler);
+  
+  try
+  {
+    file_mapping   fm(tempFilePath.c_str(), read_write);
+    mapped_region  mr(fm, read_write);
+    
+    uint64_t  *rawSeeds = reinterpret_cast<uint64_t*>
+      (static_cast<char*>(mr.get_address()) + headerSize);
+    
+    HashedSeedGenerator  seedGenerator(parameters);
+    TableSeedSearcher    seedSearcher(parameters, rawSeeds);
+    NoResultChecker      resultChecker;
+    NoResultHandler      resultHandler;
+    SearchRunner         searcher;
+    
+    searcher.SearchThreaded(seedGenerator, seedSearcher, resultChecker,
+                            resultHandler, writeProgressHandler);
+    
+    mr.flush();
+  }
+  catch (...)
+  {
+    std::remove(tempFilePath.c_str());
+    return false;
+  }
+  
+  if (writeProgressHandler.m_cancelled ||
+      (std::rename(tempFilePath.c_str(), filePath.c_str()) != 0))
+  {
+    std::remove(tempFilePath.c_str());
+    return false;
+  }
+  
+  return true;
+}
+
+HashedSeedTable::LoadResult HashedSeedTable::Load(const std::string &filePath)
+{
+  boost::shared_ptr<const HashedSeedTable>  table;
+  
+  try
+  {
+    table.reset(new HashedSeedTable(filePath));
+  }
+  catch (boost::interprocess::interprocess_exception &e)
+  {
+    return NO_TABLE_FILE;
+  }
+  catch (...)
+  {
+    return UNKNOWN_ERROR;
+  }
+  
+  if (table->m_rawSeeds == 0)
+    return BAD_TABLE_FILE;
+  
+  boost::unique_lock<boost::mutex>  lock(s_TableMutex);
+  
+  s_Table = table;
+  
+  return LOADED;
+}
+
+void HashedSeedTable::Release()
+{
+  boost::unique_lock<boost::mutex>  lock(s_TableMutex);
+  
+  s_Table.reset();
+}
+
+boost::shared_ptr<const HashedSeedTable>
+  HashedSeedTable::Find(const HashedSeedGenerator::Parameters &parameters)
+{
+  boost::unique_lock<boost::mutex>  lock(s_TableMutex);
+  
+  if (s_Table && SameProfile(s_Table->m_parameters, parameters) &&
+      (parameters.fromTime >= s_Table->m_parameters.fromTime) &&
+      (parameters.toTime <= s_Table->m_parameters.toTime))
+    return s_Table;
+  
+  return boost::shared_ptr<const HashedSeedTable>();
+}
+
+}
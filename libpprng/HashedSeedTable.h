@@ -0,0 +1,91 @@
+/*
+  Copyright (C) 2012 chiizu
+  chiizu.pprng@gmail.com
+  
+  This file is part of libpprng.
+  
+  libpprng is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  libpprng is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License
+  along with libpprng.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef HASHED_SEED_TABLE_H
+#define HASHED_SEED_TABLE_H
+
+#include "PPRNGTypes.h"
+#include "SeedGenerator.h"
+#include "SearchRunner.h"
+
+#include <string>
+#include <boost/shared_ptr.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+namespace pprng
+{
+
+// A file holding the raw seed of every seed HashedSeedGenerator gives for one
+// DS profile and range of times, in the order it gives them.  While a table
+// is loaded, generators whose parameters it covers read their raw seeds from
+// it instead of hashing each one.
+class HashedSeedTable
+{
+public:
+  enum LoadResult
+  {
+    LOADED = 0,
+    NO_TABLE_FILE,
+    BAD_TABLE_FILE,
+    UNKNOWN_ERROR
+  };
+  
+  // the directory the app keeps its table in
+  static void SetTableDirectory(const std::string &dir);
+  static std::string TableFilePath();
+  
+  // hashes all the seeds, using all cores, into a temporary file which then
+  // replaces filePath, so a search using a loaded table is never disturbed
+  static bool Write(const HashedSeedGenerator::Parameters &parameters,
+                    const std::string &filePath,
+                    const SearchRunner::ProgressCallback &progressHandler);
+  
+  // replaces any previously loaded table
+  static LoadResult Load(const std::string &filePath);
+  static void Release();
+  
+  // the loaded table, if it has the same profile and covers the times
+  static boost::shared_ptr<const HashedSeedTable>
+    Find(const HashedSeedGenerator::Parameters &parameters);
+  
+  // index of the first seed for a time
+  uint64_t SeedIndex(const boost::posix_time::ptime &time) const
+  {
+    return (time - m_parameters.fromTime).total_seconds() * m_seedsPerSecond;
+  }
+  
+  uint64_t RawSeed(uint64_t index) const { return m_rawSeeds[index]; }
+  
+private:
+  HashedSeedTable(const std::string &filePath);
+  
+  boost::interprocess::file_mapping   m_file;
+  boost::interprocess::mapped_region  m_region;
+  
+  HashedSeedGenerator::Parameters     m_parameters;
+  uint64_t                            m_seedsPerSecond;
+  const uint64_t                      *m_rawSeeds;
+};
+
+}
+
+#endif
@@ -57,9 +57,9 @@ struct FrameGeneratorFactory
     : m_memoryLinkUsed(memoryLinkUsed)
   {}
   
-  HiddenHollowSpawnFrameGenerator operator()(const HashedSeed &seed) const
+  HiddenHollowSpawnFrameGenerator* operator()(const HashedSeed &seed) const
   {
-    return HiddenHollowSpawnFrameGenerator(seed, m_memoryLinkUsed);
+    return new HiddenHollowSpawnFrameGenerator(seed, m_memoryLinkUsed);
   }
   
   bool m_memoryLinkUsed;
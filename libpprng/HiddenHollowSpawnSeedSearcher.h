@@ -55,7 +55,8 @@ public:
   };
   
   typedef HiddenHollowSpawnFrameGenerator::Frame     ResultType;
-  typedef boost::function<void (const ResultType&)>  ResultCallback;
+  typedef boost::function<void (const ResultType*, std::size_t)>
+                                                     ResultCallback;
   
   HiddenHollowSpawnSeedSearcher() {}
   
@@ -82,12 +82,18 @@ public:
   };
   
   Gen5BufferingIVRNG(RNG &rng, FrameType frameType)
-    : m_RNG(rng), m_word(0),
+    : m_RNG(rng), m_word(0), m_frameType(frameType),
       m_IVWordGenerator((frameType == Normal) ?
                         &Gen5BufferingIVRNG::NextNormalIVWord :
                         &Gen5BufferingIVRNG::NextRoamerIVWord)
   {
-    if (frameType == Roamer)
+    Reset();
+  }
+  
+  // refill the IV window after the underlying RNG has been reseeded
+  void Reset()
+  {
+    if (m_frameType == Roamer)
       m_RNG.Next();  // unknown call
     
     uint32_t  word = 0;
@@ -131,8 +137,9 @@ private:
     return result;
   }
   
-  RNG       &m_RNG;
-  uint32_t  m_word;
+  RNG              &m_RNG;
+  uint32_t         m_word;
+  const FrameType  m_frameType;
 };
 
 
@@ -175,43 +175,52 @@ DEFINE_IV_SEED_MAP(PhysTrickIVsMap, PhysTrickIVsData);
 DEFINE_IV_SEED_MAP(SpecTrickIVsMap, SpecTrickIVsData);
 DEFINE_IV_SEED_MAP(HpTrickIVsMap, HpTrickIVsData);
 
+DEFINE_IV_SEED_MAP(RoamerPerfectIVsMap, RoamerPerfectIVsData);
+DEFINE_IV_SEED_MAP(RoamerPhysIVsMap, RoamerPhysIVsData);
+DEFINE_IV_SEED_MAP(RoamerSpecIVsMap, RoamerSpecIVsData);
+DEFINE_IV_SEED_MAP(RoamerHpIVsMap, RoamerHpIVsData);
+DEFINE_IV_SEED_MAP(RoamerPerfectTrickIVsMap, RoamerPerfectTrickIVsData);
+DEFINE_IV_SEED_MAP(RoamerPhysTrickIVsMap, RoamerPhysTrickIVsData);
+DEFINE_IV_SEED_MAP(RoamerSpecTrickIVsMap, RoamerSpecTrickIVsData);
+DEFINE_IV_SEED_MAP(RoamerHpTrickIVsMap, RoamerHpTrickIVsData);
+
 }
 
 
-const IVSeedMap& GetIVSeedMap(IVPattern::Type pattern)
+const IVSeedMap& GetIVSeedMap(IVPattern::Type pattern, bool isRoamer)
 {
   switch (pattern)
   {
   case IVPattern::HEX_FLAWLESS:
-    return PerfectIVsMap;
+    return isRoamer ? RoamerPerfectIVsMap : PerfectIVsMap;
     break;
     
   case IVPattern::PHYSICAL_FLAWLESS:
-    return PhysIVsMap;
+    return isRoamer ? RoamerPhysIVsMap : PhysIVsMap;
     break;
     
   case IVPattern::SPECIAL_FLAWLESS:
-    return SpecIVsMap;
+    return isRoamer ? RoamerSpecIVsMap : SpecIVsMap;
     break;
     
   case IVPattern::SPECIAL_HIDDEN_POWER_FLAWLESS:
-    return HpIVsMap;
+    return isRoamer ? RoamerHpIVsMap : HpIVsMap;
     break;
     
   case IVPattern::HEX_FLAWLESS_TRICK:
-    return PerfectTrickIVsMap;
+    return isRoamer ? RoamerPerfectTrickIVsMap : PerfectTrickIVsMap;
     break;
     
   case IVPattern::PHYSICAL_FLAWLESS_TRICK:
-    return PhysTrickIVsMap;
+    return isRoamer ? RoamerPhysTrickIVsMap : PhysTrickIVsMap;
     break;
     
   case IVPattern::SPECIAL_FLAWLESS_TRICK:
-    return SpecTrickIVsMap;
+    return isRoamer ? RoamerSpecTrickIVsMap : SpecTrickIVsMap;
     break;
     
   case IVPattern::SPECIAL_HIDDEN_POWER_FLAWLESS_TRICK:
-    return HpTrickIVsMap;
+    return isRoamer ? RoamerHpTrickIVsMap : HpTrickIVsMap;
     break;
   
   case IVPattern::CUSTOM:
@@ -308,4 +317,69 @@ const IVSeedHash& GetIVSeedHash(IVPattern::Type pattern, bool isRoamer)
   }
 }
 
+
+
+bool IVSeedCacheCovers(IVPattern::Type pattern,
+                       const IVs &min, const IVs &max,
+                       uint32_t hiddenTypeMask, uint32_t minHiddenPower)
+{
+  IVs   cacheMin, cacheMax;
+  bool  isHiddenPowerCache = false;
+  
+  switch (pattern)
+  {
+  case IVPattern::HEX_FLAWLESS:
+    cacheMin = IVs::Perfect;
+    cacheMax = IVs::Perfect;
+    break;
+    
+  case IVPattern::PHYSICAL_FLAWLESS:
+    cacheMin = IVs::PhysPerfect;
+    cacheMax = IVs::Perfect;
+    break;
+    
+  case IVPattern::SPECIAL_FLAWLESS:
+    cacheMin = IVs::SpecPerfect;
+    cacheMax = IVs::Perfect;
+    break;
+    
+  case IVPattern::SPECIAL_HIDDEN_POWER_FLAWLESS:
+    cacheMin = IVs::HpPerfectLow;
+    cacheMax = IVs::HpPerfectHigh;
+    isHiddenPowerCache = true;
+    break;
+    
+  case IVPattern::HEX_FLAWLESS_TRICK:
+    cacheMin = IVs::PerfectTrick;
+    cacheMax = IVs::PerfectTrick;
+    break;
+    
+  case IVPattern::PHYSICAL_FLAWLESS_TRICK:
+    cacheMin = IVs::PhysPerfectTrick;
+    cacheMax = IVs::PerfectTrick;
+    break;
+    
+  case IVPattern::SPECIAL_FLAWLESS_TRICK:
+    cacheMin = IVs::SpecPerfectTrick;
+    cacheMax = IVs::PerfectTrick;
+    break;
+    
+  case IVPattern::SPECIAL_HIDDEN_POWER_FLAWLESS_TRICK:
+    cacheMin = IVs::HpPerfectTrickLow;
+    cacheMax = IVs::HpPerfectTrickHigh;
+    isHiddenPowerCache = true;
+    break;
+  
+  case IVPattern::CUSTOM:
+  default:
+    return false;
+    break;
+  }
+  
+  // the hidden power sets only hold seeds with 70 power hidden powers
+  return min.betterThanOrEqual(cacheMin) && max.worseThanOrEqual(cacheMax) &&
+         (!isHiddenPowerCache ||
+          ((hiddenTypeMask != 0) && (minHiddenPower >= 70)));
+}
+
 }
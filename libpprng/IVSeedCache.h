@@ -55,14 +55,29 @@ enum
   IVSeedMapMaxFrame = 103
 };
 
+// roamer IV frames are counted from after the roamer's unknown call, and the
+// IVs come out in a different order, so roamers have their own data
+//  BW   - max roamer IV frame 6
+//  B2W2 - max roamer IV frame 4
+enum
+{
+  IVSeedRoamerMaxFrame = 6
+};
+
 typedef boost::container::flat_multimap<uint32_t, SeedData> IVSeedMap;
 
-const IVSeedMap& GetIVSeedMap(IVPattern::Type pattern);
+const IVSeedMap& GetIVSeedMap(IVPattern::Type pattern, bool isRoamer = false);
+
+inline uint32_t IVSeedMapMaxFrameFor(bool isRoamer)
+{
+  return isRoamer ? uint32_t(IVSeedRoamerMaxFrame) :
+                    uint32_t(IVSeedMapMaxFrame);
+}
 
 
 
 
-// holds a data up to IV frame 8, supports BW roamers - faster than map above
+// holds a data up to IV frame 8, and roamer data - faster than map above
 //  BW   - max IV frame 8
 //  B2W2 - max IV frame 6
 enum
@@ -74,6 +89,22 @@ typedef boost::unordered_map<uint32_t, std::vector<SeedData> > IVSeedHash;
 
 const IVSeedHash& GetIVSeedHash(IVPattern::Type pattern, bool isRoamer);
 
+inline uint32_t IVSeedHashMaxFrameFor(bool isRoamer)
+{
+  return isRoamer ? uint32_t(IVSeedRoamerMaxFrame) :
+                    uint32_t(IVSeedHashMaxFrame);
+}
+
+
+
+
+// whether the cached seeds of a pattern include every seed whose IVs are
+// within min - max and have the given hidden power (hiddenTypeMask 0 for any),
+// so that the cache can be searched and its results filtered
+bool IVSeedCacheCovers(IVPattern::Type pattern,
+                       const IVs &min, const IVs &max,
+                       uint32_t hiddenTypeMask, uint32_t minHiddenPower);
+
 }
 
 #endif
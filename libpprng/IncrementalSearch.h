@@ -0,0 +1,138 @@
+/*
+  Copyright (C) 2012 chiizu
+  chiizu.pprng@gmail.com
+  
+  This file is part of libpprng.
+  
+  libpprng is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  libpprng is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License
+  along with libpprng.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef INCREMENTAL_SEARCH_H
+#define INCREMENTAL_SEARCH_H
+
+#include "PPRNGTypes.h"
+#include "HashedSeed.h"
+#include "SeedGenerator.h"
+#include "SearchRunner.h"
+
+#include <vector>
+#include <algorithm>
+#include <boost/function.hpp>
+
+namespace pprng
+{
+
+// Shared by the searchers that keep their last search's results, to tell
+// whether new criteria are covered by the last search, to keep the results
+// as they are handed on, and to run a search as several parts.
+
+inline bool HasButtons(const Button::List &buttons, uint32_t heldButtons)
+{
+  return std::find(buttons.begin(), buttons.end(), heldButtons) !=
+         buttons.end();
+}
+
+inline bool ButtonsCover(const Button::List &outer, const Button::List &inner)
+{
+  Button::List::const_iterator  i;
+  for (i = inner.begin(); i != inner.end(); ++i)
+  {
+    if (!HasButtons(outer, *i))
+      return false;
+  }
+  
+  return true;
+}
+
+// whether every seed of inner is also a seed of outer
+inline bool SeedParametersCover(const HashedSeedGenerator::Parameters &outer,
+                                const HashedSeedGenerator::Parameters &inner)
+{
+  return (outer.version == inner.version) &&
+         (outer.dsType == inner.dsType) &&
+         (outer.macAddress == inner.macAddress) &&
+         (inner.fromTime >= outer.fromTime) &&
+         (inner.toTime <= outer.toTime) &&
+         (inner.timer0Low >= outer.timer0Low) &&
+         (inner.timer0High <= outer.timer0High) &&
+         (inner.vcountLow >= outer.vcountLow) &&
+         (inner.vcountHigh <= outer.vcountHigh) &&
+         (inner.vframeLow >= outer.vframeLow) &&
+         (inner.vframeHigh <= outer.vframeHigh) &&
+         ButtonsCover(outer.heldButtons, inner.heldButtons);
+}
+
+// whether the seed is one of those the parameters generate
+inline bool SeedParametersHold(const HashedSeedGenerator::Parameters &p,
+                               const HashedSeed::Parameters &seed)
+{
+  using namespace boost::posix_time;
+  
+  ptime  time(seed.date, hours(seed.hour) + minutes(seed.minute) +
+                         seconds(seed.second));
+  
+  return (seed.version == p.version) && (seed.dsType == p.dsType) &&
+         (seed.macAddress == p.macAddress) &&
+         (time >= p.fromTime) && (time <= p.toTime) &&
+         (seed.timer0 >= p.timer0Low) && (seed.timer0 <= p.timer0High) &&
+         (seed.vcount >= p.vcountLow) && (seed.vcount <= p.vcountHigh) &&
+         (seed.vframe >= p.vframeLow) && (seed.vframe <= p.vframeHigh) &&
+         HasButtons(p.heldButtons, seed.heldButtons);
+}
+
+// keeps each batch of results before passing it on
+template <class ResultType>
+struct StoringResultHandler
+{
+  typedef boost::function<void (const ResultType*, std::size_t)>
+                                                     ResultCallback;
+  
+  StoringResultHandler(std::vector<ResultType> &results,
+                       const ResultCallback &resultHandler)
+    : m_results(results), m_resultHandler(resultHandler)
+  {}
+  
+  void operator()(const ResultType *results, std::size_t numResults) const
+  {
+    m_results.insert(m_results.end(), results, results + numResults);
+    m_resultHandler(results, numResults);
+  }
+  
+  std::vector<ResultType>  &m_results;
+  const ResultCallback     &m_resultHandler;
+};
+
+// spreads progress over several searches, and notes cancellation
+struct PartProgressHandler
+{
+  PartProgressHandler(const SearchRunner::ProgressCallback &progressHandler)
+    : m_progressHandler(progressHandler), m_share(1.0), m_cancelled(false)
+  {}
+  
+  bool operator()(double progress)
+  {
+    m_cancelled = m_cancelled || !m_progressHandler(progress * m_share);
+    
+    return !m_cancelled;
+  }
+  
+  const SearchRunner::ProgressCallback  &m_progressHandler;
+  double                                m_share;
+  bool                                  m_cancelled;
+};
+
+}
+
+#endif
@@ -22,9 +22,11 @@
 #include "InitialSeedSearcher.h"
 #include "LinearCongruentialRNG.h"
 #include "FrameGenerator.h"
+#include "IncrementalSearch.h"
 #include <iostream>
 #include <iomanip>
 #include <set>
+#include <algorithm>
 
 namespace pprng
 {
@@ -85,8 +87,9 @@ struct B2W2InitialSeedChecker
     return seedSpins.word == m_spins.word;
   }
   
+  template <class ResultCallback>
   void Search(const HashedSeed &seed, const B2W2InitialSeedChecker &checker,
-              const B2W2InitialSeedSearcher::ResultCallback &resultHandler)
+              const ResultCallback &resultHandler)
   {
     if (checker(seed))
       resultHandler(seed);
@@ -110,4 +113,65 @@ void B2W2InitialSeedSearcher::Search
                           resultHandler, progressHandler);
 }
 
+
+void IncrementalB2W2InitialSeedSearcher::Search
+  (const Criteria &criteria, const ResultCallback &resultHandler,
+   const SearchRunner::ProgressCallback &progressHandler)
+{
+  std::vector<ResultType>  results;
+  
+  if (m_hasResults &&
+      (criteria.memoryLinkUsed == m_criteria.memoryLinkUsed) &&
+      criteria.spins.Contains(m_criteria.spins) &&
+      SeedParametersCover(m_criteria.seedParameters, criteria.seedParameters))
+  {
+    // the seeds found are few, so walking each one's spinner again is quick
+    B2W2InitialSeedChecker  seedChecker(criteria.spins,
+                                        criteria.memoryLinkUsed);
+    
+    std::vector<ResultType>::const_iterator  i;
+    for (i = m_results.begin(); i != m_results.end(); ++i)
+    {
+      if (SeedParametersHold(criteria.seedParameters, i->parameters) &&
+          seedChecker(*i))
+        results.push_back(*i);
+    }
+    
+    if (!results.empty())
+      resultHandler(&results[0], results.size());
+    
+    progressHandler(100.0);
+    
+    m_criteria = criteria;
+    m_results.swap(results);
+    
+    return;
+  }
+  
+  // the stored results are incomplete until the search finishes
+  m_hasResults = false;
+  
+  StoringResultHandler<ResultType>  storingResultHandler(results,
+                                                         resultHandler);
+  PartProgressHandler               partProgressHandler(progressHandler);
+  B2W2InitialSeedSearcher           searcher;
+  
+  searcher.Search(criteria, storingResultHandler,
+                  boost::ref(partProgressHandler));
+  
+  if (!partProgressHandler.m_cancelled)
+  {
+    m_criteria = criteria;
+    m_results.swap(results);
+    m_hasResults = true;
+  }
+}
+
+void IncrementalB2W2InitialSeedSearcher::Reset()
+{
+  m_hasResults = false;
+  m_criteria = Criteria();
+  m_results.clear();
+}
+
 }
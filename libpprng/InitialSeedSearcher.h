@@ -76,7 +76,8 @@ public:
   };
   
   typedef HashedSeed                                 ResultType;
-  typedef boost::function<void (const ResultType&)>  ResultCallback;
+  typedef boost::function<void (const ResultType*, std::size_t)>
+                                                     ResultCallback;
   
   B2W2InitialSeedSearcher() {}
   
@@ -85,6 +86,34 @@ public:
               const SearchRunner::ProgressCallback &progressHandler);
 };
 
+// Keeps the criteria and results of its last search.  When spins are added
+// to the last search's spins, and its seed parameters are the same or
+// narrower, only the seeds it found are checked again.  Anything else is
+// searched in full.
+class IncrementalB2W2InitialSeedSearcher
+{
+public:
+  typedef B2W2InitialSeedSearcher::Criteria        Criteria;
+  typedef B2W2InitialSeedSearcher::ResultType      ResultType;
+  typedef B2W2InitialSeedSearcher::ResultCallback  ResultCallback;
+  
+  IncrementalB2W2InitialSeedSearcher()
+    : m_hasResults(false), m_criteria(), m_results()
+  {}
+  
+  void Search(const Criteria &criteria,
+              const ResultCallback &resultHandler,
+              const SearchRunner::ProgressCallback &progressHandler);
+  
+  // forgets the last search
+  void Reset();
+  
+private:
+  bool                     m_hasResults;
+  Criteria                 m_criteria;
+  std::vector<ResultType>  m_results;
+};
+
 }
 
 #endif
@@ -54,6 +54,22 @@ public:
   {
     return (seed * Mux) + Inc;
   }
+  
+  // jump ahead numFrames in O(log(numFrames)) steps
+  void AdvanceFrames(uint64_t numFrames)
+  {
+    IntegerType  mux = Mux, inc = Inc;
+    
+    while (numFrames > 0)
+    {
+      if (numFrames & 0x1)
+        m_seed = (m_seed * mux) + inc;
+      
+      inc = inc * (mux + 1);
+      mux = mux * mux;
+      numFrames >>= 1;
+    }
+  }
 
 private:
   IntegerType  m_seed;
@@ -251,6 +251,63 @@ LazyMersenneTwisterRNG::operator=(const LazyMersenneTwisterRNG &c)
   return *this;
 }
 
+void LazyMersenneTwisterRNG::Seed(uint32_t seed)
+{
+  m_mti = 0;
+  m_nextUInt32Generator = &LazyMersenneTwisterRNG::FirstSectionLNextUInt32;
+  
+  InitGenRand(seed);
+}
+
+// The second output twists mt[1] and mt[2] with mt[M + 1], so those are the
+// only words of the initialization that need keeping.  Each initialization
+// is one long chain of dependent multiplies, so seeds are worked through in
+// batches whose chains can overlap.
+void LazyMersenneTwisterRNG::SecondOutputsForSeeds(const uint32_t seeds[],
+                                                   uint32_t outputs[],
+                                                   uint32_t numSeeds)
+{
+  enum { BatchSize = 8 };
+  
+  uint32_t  mt1[BatchSize], mt2[BatchSize], mt[BatchSize];
+  
+  for (uint32_t first = 0; first < numSeeds; first += BatchSize)
+  {
+    uint32_t  i;
+    
+    // the last batch is padded with repeats of its final seed
+    for (i = 0; i < BatchSize; ++i)
+    {
+      uint32_t  seed = seeds[((first + i) < numSeeds) ? (first + i) :
+                                                        (numSeeds - 1)];
+      
+      mt1[i] = (1812433253UL * (seed ^ (seed >> 30))) + 1;
+      mt2[i] = (1812433253UL * (mt1[i] ^ (mt1[i] >> 30))) + 2;
+      mt[i] = mt2[i];
+    }
+    
+    for (uint32_t mti = 3; mti <= (M + 1); ++mti)
+    {
+      for (i = 0; i < BatchSize; ++i)
+        mt[i] = (1812433253UL * (mt[i] ^ (mt[i] >> 30))) + mti;
+    }
+    
+    for (i = 0; (i < BatchSize) && ((first + i) < numSeeds); ++i)
+    {
+      uint32_t  y = (mt1[i] & UPPER_MASK) | (mt2[i] & LOWER_MASK);
+      
+      y = mt[i] ^ (y >> 1) ^ ((y & 0x1) * MATRIX_A);
+      
+      y ^= y >> 11;
+      y ^= (y << 7) & 0x9d2c5680UL;
+      y ^= (y << 15) & 0xefc60000UL;
+      y ^= y >> 18;
+      
+      outputs[first + i] = y;
+    }
+  }
+}
+
 /* initializes first M members of mt[N] with a seed (minimum initialization) */
 void LazyMersenneTwisterRNG::InitGenRand(uint32_t seed)
 {
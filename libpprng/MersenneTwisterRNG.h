@@ -132,6 +132,14 @@ public:
   LazyMersenneTwisterRNG(const LazyMersenneTwisterRNG&);
   LazyMersenneTwisterRNG& operator=(const LazyMersenneTwisterRNG&);
   
+  // restart the sequence from a new seed without reallocating
+  void Seed(uint32_t seed);
+  
+  // the second output for each of numSeeds seeds, as used for Gen 4 trainer
+  // IDs, without storing any state
+  static void SecondOutputsForSeeds(const uint32_t seeds[], uint32_t outputs[],
+                                    uint32_t numSeeds);
+  
   ReturnType Next() { return NextUInt32(); }
 
   /* generates a random number on [0,0xffffffff]-interval */
@@ -63,11 +63,17 @@ public:
   BufferedRNG(typename RNG::SeedType seed)
     : m_RNG(seed), m_end(NumBufferedResults - 1), m_pos(0)
   {
-    // fill the buffer
-    for (uint32_t i = 0; i < (NumBufferedResults - 1); ++i)
-    {
-      m_buffer[i] = m_RNG.Next();
-    }
+    FillBuffer();
+  }
+  
+  // equivalent to constructing a new BufferedRNG with the given seed
+  void Seed(typename RNG::SeedType seed)
+  {
+    m_RNG.Seed(seed);
+    m_end = NumBufferedResults - 1;
+    m_pos = 0;
+    
+    FillBuffer();
   }
   
   ReturnType Next()
@@ -105,6 +111,14 @@ public:
   }
   
 private:
+  void FillBuffer()
+  {
+    for (uint32_t i = 0; i < (NumBufferedResults - 1); ++i)
+    {
+      m_buffer[i] = m_RNG.Next();
+    }
+  }
+  
   RNG             m_RNG;
   ReturnType      m_buffer[BufferSize];
   uint32_t        m_end;
@@ -22,29 +22,61 @@
 #define SEARCH_RUNNER_H
 
 #include <deque>
+#include <vector>
 #include <boost/shared_ptr.hpp>
 #include <boost/thread.hpp>
+#include <boost/function.hpp>
 #include <functional>
 
 namespace pprng
 {
 
+// Searchers hand results to their callers in batches, through callbacks of
+// the form void (const ResultType *results, std::size_t numResults).
+// Everything below the public Search methods is templated on its checker and
+// handler types, so the only indirect call is once per batch.
+template <class ResultType, class ResultHandler>
+struct EachResultHandler
+{
+  EachResultHandler(const ResultHandler &resultHandler)
+    : m_resultHandler(resultHandler)
+  {}
+  
+  void operator()(const ResultType *results, std::size_t numResults)
+  {
+    for (std::size_t i = 0; i < numResults; ++i)
+      m_resultHandler(results[i]);
+  }
+  
+  ResultHandler  m_resultHandler;
+};
+
+// adapts a handler taking one result at a time to a batched result callback
+template <class ResultType, class ResultHandler>
+inline EachResultHandler<ResultType, ResultHandler>
+ForEachResult(const ResultHandler &resultHandler)
+{
+  return EachResultHandler<ResultType, ResultHandler>(resultHandler);
+}
+
 class SearchRunner
 {
 public:
   typedef boost::function<bool (double)>  ProgressCallback;
   
+  // resultHandler is called with each chunk's results as one batch
   template <class SeedGenerator, class SeedSearcher, class ResultChecker,
-            class ResultCallback>
+            class ResultCallback, class ProgressHandler>
   void Search(SeedGenerator &seedGenerator,
               SeedSearcher &seedSearcher,
               ResultChecker &resultChecker,
               ResultCallback &resultHandler,
-              const ProgressCallback &progressHandler,
+              ProgressHandler &progressHandler,
               uint32_t numSplits = 1)
   {
     typedef typename SeedGenerator::SeedType               SeedType;
     typedef typename SeedGenerator::SeedCountType          SeedCountType;
+    typedef typename SeedSearcher::ResultType              ResultType;
     
     SeedCountType  numSeeds = seedGenerator.NumberOfSeeds();
     
@@ -60,6 +92,9 @@ public:
     
     SeedCountType  threshold = stepPercentSeeds;
     
+    std::vector<ResultType>      results;
+    ResultCollector<ResultType>  resultCollector(results);
+    
     for (typename SeedGenerator::SeedCountType i = 0;
          (i < numSeeds) && progressHandler(stepPercent);
          /* empty */)
@@ -68,7 +103,13 @@ public:
       {
         SeedType  seed = seedGenerator.Next();
         
-        seedSearcher.Search(seed, resultChecker, resultHandler);
+        seedSearcher.Search(seed, resultChecker, resultCollector);
+      }
+      
+      if (!results.empty())
+      {
+        resultHandler(&results[0], results.size());
+        results.clear();
       }
       
       threshold += stepPercentSeeds;
@@ -80,19 +121,19 @@ public:
   }
   
   template <class SeedGenerator, class SeedSearcher, class ResultChecker,
-            class ResultCallback>
+            class ResultCallback, class ProgressHandler>
   void SearchThreaded(SeedGenerator &seedGenerator,
                       SeedSearcher &seedSearcher,
                       ResultChecker &resultChecker,
                       ResultCallback &resultHandler,
-                      const ProgressCallback &progressHandler)
+                      ProgressHandler &progressHandler)
   {
     typedef typename SeedSearcher::ResultType  ResultType;
     
     boost::condition_variable  progressUpdate;
     boost::mutex               progressMutex,  resultMutex;
     std::deque<double>         progressQueue;
-    std::deque<ResultType>     resultQueue;
+    std::vector<ResultType>    resultQueue, results;
     bool                       shouldContinue = true;
     
     uint32_t  numProcs = boost::thread::hardware_concurrency();
@@ -141,39 +182,123 @@ public:
         }
       }
       
-      // look for new results
+      // look for new results, handing them on without holding the lock
       {
         boost::lock_guard<boost::mutex>  lock(resultMutex);
-        while (!resultQueue.empty())
-        {
-          resultHandler(resultQueue.front());
-          resultQueue.pop_front();
-        }
+        results.swap(resultQueue);
+      }
+      
+      if (!results.empty())
+      {
+        resultHandler(&results[0], results.size());
+        results.clear();
       }
     }
     
     ThreadList::iterator  it;
     for (it = threadList.begin(); it != threadList.end(); ++it)
       (*it)->join();
+    
+    // the last threads may have queued results while the handler was busy
+    if (!resultQueue.empty())
+      resultHandler(&resultQueue[0], resultQueue.size());
+  }
+  
+  // For two stage searches, where each result of the seed searcher is only a
+  // candidate for a more expensive second stage.  Cheap conversions can stay
+  // in resultHandler, but an expensive stage run there would serialise the
+  // whole search on this thread.  Instead secondStage(result, handler) is
+  // called within the worker threads, handing on any number of
+  // SecondStage::ResultType results, and only those reach resultHandler.
+  template <class SeedGenerator, class SeedSearcher, class ResultChecker,
+            class SecondStage, class ResultCallback, class ProgressHandler>
+  void SearchThreaded(SeedGenerator &seedGenerator,
+                      SeedSearcher &seedSearcher,
+                      ResultChecker &resultChecker,
+                      const SecondStage &secondStage,
+                      ResultCallback &resultHandler,
+                      ProgressHandler &progressHandler)
+  {
+    StagedSeedSearcher<SeedSearcher, SecondStage>  stagedSearcher(seedSearcher,
+                                                                  secondStage);
+    
+    SearchThreaded(seedGenerator, stagedSearcher, resultChecker,
+                   resultHandler, progressHandler);
   }
   
 private:
+  template <class SecondStage, class ResultCallback>
+  struct StageResultHandler
+  {
+    StageResultHandler(const SecondStage &secondStage,
+                       const ResultCallback &resultHandler)
+      : m_secondStage(secondStage), m_resultHandler(resultHandler)
+    {}
+    
+    template <class Result>
+    void operator()(const Result &result) const
+    {
+      m_secondStage(result, m_resultHandler);
+    }
+    
+    const SecondStage     &m_secondStage;
+    const ResultCallback  &m_resultHandler;
+  };
+  
+  template <class SeedSearcher, class SecondStage>
+  struct StagedSeedSearcher
+  {
+    typedef typename SecondStage::ResultType  ResultType;
+    
+    StagedSeedSearcher(const SeedSearcher &seedSearcher,
+                       const SecondStage &secondStage)
+      : m_seedSearcher(seedSearcher), m_secondStage(secondStage)
+    {}
+    
+    template <class SeedType, class ResultChecker, class ResultCallback>
+    void Search(const SeedType &seed, const ResultChecker &resultChecker,
+                const ResultCallback &resultHandler)
+    {
+      m_seedSearcher.Search(seed, resultChecker,
+                            StageResultHandler<SecondStage, ResultCallback>
+                              (m_secondStage, resultHandler));
+    }
+    
+    SeedSearcher       m_seedSearcher;  // copied with this, one per thread
+    const SecondStage  &m_secondStage;
+  };
+  
+  template <typename ResultType>
+  struct ResultCollector
+  {
+    ResultCollector(std::vector<ResultType> &results)
+      : m_results(results)
+    {}
+    
+    void operator()(const ResultType &result) const
+    {
+      m_results.push_back(result);
+    }
+    
+    std::vector<ResultType>  &m_results;
+  };
+  
   template <typename ResultType>
   struct ThreadResultHandler
   {
-    ThreadResultHandler(boost::mutex &mut, std::deque<ResultType> &queue)
+    ThreadResultHandler(boost::mutex &mut, std::vector<ResultType> &queue)
       : m_mut(mut), m_queue(queue)
     {}
     
-    void operator()(const ResultType &result)
+    void operator()(const ResultType *results, std::size_t numResults)
     {
       boost::lock_guard<boost::mutex>  lock(m_mut);
       
-      m_queue.push_back(result);
+      m_queue.insert(m_queue.end(), results, results + numResults);
     }
     
-    boost::mutex            &m_mut;
-    std::deque<ResultType>  &m_queue;
+    boost::mutex             &m_mut;
+    std::vector<ResultType>  &m_queue;
   };
   
   struct ThreadProgressHandler
@@ -222,7 +347,7 @@ private:
   {
     SearchFunctor(SearchRunner &searcher,
                   SeedGenerator &seedGenerator,
-                  SeedSearcher &seedSearcher,
+                  const SeedSearcher &seedSearcher,
                   ResultChecker &resultChecker,
                   ThreadResultHandler<ResultType> &resultHandler,
                   ThreadProgressHandler &progressHandler,
@@ -246,7 +371,7 @@ private:
     
     SearchRunner                     &m_searcher;
     SeedGenerator                    &m_seedGenerator;
-    SeedSearcher                     &m_seedSearcher;
+    SeedSearcher                     m_seedSearcher;  // one per thread
     ResultChecker                    &m_resultChecker;
     ThreadResultHandler<ResultType>  &m_resultHandler;
     ThreadProgressHandler            &m_progressHandler;
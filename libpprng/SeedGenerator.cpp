@@ -21,8 +21,10 @@
 
 #include "SeedGenerator.h"
 #include "HashedSeed.h"
+#include "HashedSeedTable.h"
 #include "LinearCongruentialRNG.h"
 #include <iostream>
+#include <algorithm>
 
 using namespace boost::posix_time;
 using namespace boost::gregorian;
@@ -47,6 +49,26 @@ static bool ShouldIterateHpAtkDef(IVs minIVs, IVs maxIVs)
   return numCombosLo < numCombosHi;
 }
 
+// number of RNG steps above which it is cheaper to check each candidate seed
+// in full than to look at the other IV word up front
+static const uint64_t  MaxLowHalfSearchCost = 0x10000000ULL;
+
+// the affine map, (mux * seed) + inc, that advances an RNG numFrames frames
+template <class RNG>
+static void CalculateFrameJump(uint32_t numFrames, uint32_t &mux, uint32_t &inc)
+{
+  uint32_t  fromZero = 0, fromOne = 1;
+  
+  while (numFrames-- > 0)
+  {
+    fromZero = RNG::NextForSeed(fromZero);
+    fromOne = RNG::NextForSeed(fromOne);
+  }
+  
+  inc = fromZero;
+  mux = fromOne - fromZero;
+}
+
 }
 
 Gen34IVSeedGenerator::Gen34IVSeedGenerator(IVs minIVs, IVs maxIVs,
@@ -55,61 +77,210 @@ Gen34IVSeedGenerator::Gen34IVSeedGenerator(IVs minIVs, IVs maxIVs,
     m_iteratingHpAtDef(ShouldIterateHpAtkDef(minIVs, maxIVs)),
     m_numRollbacks(m_iteratingHpAtDef ?
                     (((m_method == 2) || (m_method == 3)) ? 1 : 0) :
-                    ((m_method == 4) ? 2 : 1)),
+                    ((m_method == 1) ? 1 : 2)),
     m_iv0(0), m_iv1(0), m_iv2(0),
     m_iv0Low(0), m_iv0High(0), m_iv1Low(0), m_iv1High(0),
     m_iv2Low(0), m_iv2High(0),
-    m_otherHalfCounter(0x1ffff)
+    m_otherWordMux(0), m_otherWordInc(0), m_lowHalfSearch(AllLowHalves),
+    m_otherUpperHalves(), m_otherUpperHalfMatches(),
+    m_lowByteProducts(), m_ivWordSeeds(), m_ivWordSeedIndex(0),
+    m_firstIVCombination(0), m_numIVCombinations(0),
+    m_numSeedsCounted(false), m_numSeeds(0)
 {
+  IVs  otherMinIVs, otherMaxIVs;
+  
+  // the other IV word is generated 1 frame away, or 2 for method 4
+  uint32_t  otherWordFrames = (m_method == 4) ? 2 : 1;
+  
   if (m_iteratingHpAtDef)
   {
     m_iv0Low = minIVs.hp(); m_iv0High = maxIVs.hp();
     m_iv1Low = minIVs.at(); m_iv1High = maxIVs.at();
     m_iv2Low = minIVs.df(); m_iv2High = maxIVs.df();
+    
+    otherMinIVs = IVs(minIVs.sp(), minIVs.sa(), minIVs.sd(), 0, 0, 0);
+    otherMaxIVs = IVs(maxIVs.sp(), maxIVs.sa(), maxIVs.sd(), 0, 0, 0);
+    
+    CalculateFrameJump<LCRNG34>(otherWordFrames,
+                                m_otherWordMux, m_otherWordInc);
   }
   else
   {
     m_iv0Low = minIVs.sp(); m_iv0High = maxIVs.sp();
     m_iv1Low = minIVs.sa(); m_iv1High = maxIVs.sa();
     m_iv2Low = minIVs.sd(); m_iv2High = maxIVs.sd();
+    
+    otherMinIVs = IVs(minIVs.hp(), minIVs.at(), minIVs.df(), 0, 0, 0);
+    otherMaxIVs = IVs(maxIVs.hp(), maxIVs.at(), maxIVs.df(), 0, 0, 0);
+    
+    CalculateFrameJump<LCRNG34_R>(otherWordFrames,
+                                  m_otherWordMux, m_otherWordInc);
+  }
+  
+  // upper halves of the RNG state that would give an in range other IV word
+  boost::shared_ptr<std::vector<uint32_t> >  otherUpperHalves
+    (new std::vector<uint32_t>());
+  boost::shared_ptr<std::vector<bool> >      otherUpperHalfMatches
+    (new std::vector<bool>(0x10000, false));
+  
+  for (uint32_t iv2 = otherMinIVs.df(); iv2 <= otherMaxIVs.df(); ++iv2)
+  {
+    for (uint32_t iv1 = otherMinIVs.at(); iv1 <= otherMaxIVs.at(); ++iv1)
+    {
+      for (uint32_t iv0 = otherMinIVs.hp(); iv0 <= otherMaxIVs.hp(); ++iv0)
+      {
+        for (uint32_t unusedBit = 0; unusedBit < 2; ++unusedBit)
+        {
+          uint32_t  upperHalf =
+            (unusedBit << 15) | (iv2 << 10) | (iv1 << 5) | iv0;
+          
+          otherUpperHalves->push_back(upperHalf);
+          (*otherUpperHalfMatches)[upperHalf] = true;
+        }
+      }
+    }
+  }
+  
+  m_otherUpperHalves = otherUpperHalves;
+  m_otherUpperHalfMatches = otherUpperHalfMatches;
+  
+  uint64_t  numIVWords = NumberOfIVCombinations();
+  uint64_t  numOtherUpperHalves = m_otherUpperHalves->size();
+  
+  if (numOtherUpperHalves < 0x10000)
+  {
+    // solving takes a binary search for each of 256 high bytes of the low half
+    uint64_t  solveCost = numOtherUpperHalves * 256 * 8;
+    uint64_t  scanCost = 0x10000;
+    uint64_t  cost = (solveCost < scanCost) ? solveCost : scanCost;
+    
+    if ((numIVWords * 2 * cost) <= MaxLowHalfSearchCost)
+    {
+      m_lowHalfSearch =
+        (solveCost < scanCost) ? SolveForLowHalves : ScanLowHalves;
+    }
   }
   
-  m_iv0 = m_iv0High;
-  m_iv1 = m_iv1High;
-  m_iv2 = m_iv2High;
+  if (m_lowHalfSearch == SolveForLowHalves)
+  {
+    for (uint32_t lowByte = 0; lowByte < 0x100; ++lowByte)
+    {
+      m_lowByteProducts.push_back
+        (std::make_pair(m_otherWordMux * lowByte, lowByte));
+    }
+    
+    std::sort(m_lowByteProducts.begin(), m_lowByteProducts.end());
+  }
+  
+  SetIVCombinationRange(0, numIVWords);
 }
 
 Gen34IVSeedGenerator::SeedCountType Gen34IVSeedGenerator::NumberOfSeeds() const
 {
-  uint32_t  mask = m_iteratingHpAtDef ? 0x00007fff : 0x7fff0000;
+  if (!m_numSeedsCounted)
+  {
+    uint32_t  end = m_firstIVCombination + m_numIVCombinations;
+    
+    m_numSeeds = 0;
+    
+    for (uint32_t i = m_firstIVCombination; i < end; ++i)
+    {
+      uint32_t  iv0, iv1, iv2;
+      
+      GetIVCombination(i, iv0, iv1, iv2);
+      m_numSeeds += SearchIVWordSeeds(iv0, iv1, iv2, 0);
+    }
+    
+    m_numSeedsCounted = true;
+  }
+  
+  return m_numSeeds;
+}
+
+std::list<Gen34IVSeedGenerator> Gen34IVSeedGenerator::Split(uint32_t parts)
+{
+  std::list<Gen34IVSeedGenerator>  result;
+  
+  uint32_t  numCombinations = NumberOfIVCombinations();
+  
+  if (parts > numCombinations)
+    parts = numCombinations;
+  
+  uint32_t  first = 0;
+  for (uint32_t i = 0; i < parts; ++i)
+  {
+    uint32_t  next = (uint64_t(numCombinations) * (i + 1)) / parts;
+    
+    Gen34IVSeedGenerator  part(*this);
+    part.SetIVCombinationRange(first, next - first);
+    
+    result.push_back(part);
+    
+    first = next;
+  }
+  
+  return result;
+}
+
+uint32_t Gen34IVSeedGenerator::NumberOfIVCombinations() const
+{
+  return (m_iv0High - m_iv0Low + 1) * (m_iv1High - m_iv1Low + 1) *
+         (m_iv2High - m_iv2Low + 1);
+}
+
+// IV combinations are numbered in iteration order, with iv0 varying fastest
+void Gen34IVSeedGenerator::GetIVCombination
+  (uint32_t index, uint32_t &iv0, uint32_t &iv1, uint32_t &iv2) const
+{
+  uint32_t  numIV0s = m_iv0High - m_iv0Low + 1;
+  uint32_t  numIV1s = m_iv1High - m_iv1Low + 1;
+  
+  iv0 = m_iv0Low + (index % numIV0s);
+  iv1 = m_iv1Low + ((index / numIV0s) % numIV1s);
+  iv2 = m_iv2Low + (index / (numIV0s * numIV1s));
+}
+
+void Gen34IVSeedGenerator::SetIVCombinationRange(uint32_t first,
+                                                 uint32_t count)
+{
+  // start on the combination before the first, which Next moves on from
+  if (first == 0)
+  {
+    m_iv0 = m_iv0High;
+    m_iv1 = m_iv1High;
+    m_iv2 = m_iv2High;
+  }
+  else
+  {
+    GetIVCombination(first - 1, m_iv0, m_iv1, m_iv2);
+  }
+  
+  m_ivWordSeeds.clear();
+  m_ivWordSeedIndex = 0;
+  
+  m_firstIVCombination = first;
+  m_numIVCombinations = count;
   
-  return IVs::CalculateNumberOfCombinations(IVs(m_minIVs.word & mask),
-                                            IVs(m_maxIVs.word & mask)) *
-         (0x1ffff + 1);
+  if (m_lowHalfSearch == AllLowHalves)
+  {
+    m_numSeeds = count * 0x20000;
+    m_numSeedsCounted = true;
+  }
+  else
+  {
+    m_numSeedsCounted = false;
+  }
 }
 
 Gen34IVSeedGenerator::SeedType Gen34IVSeedGenerator::Next()
 {
-  if (++m_otherHalfCounter > 0x1ffff)
+  while (m_ivWordSeedIndex >= m_ivWordSeeds.size())
   {
-    m_otherHalfCounter = 0;
-    if (++m_iv0 > m_iv0High)
-    {
-      m_iv0 = m_iv0Low;
-      if (++m_iv1 > m_iv1High)
-      {
-        m_iv1 = m_iv1Low;
-        if (++m_iv2 > m_iv2High)
-        {
-          m_iv2 = m_iv2Low;
-        }
-      }
-    }
+    NextIVCombination();
+    FindIVWordSeeds();
   }
   
-  uint32_t  seed = ((m_otherHalfCounter & 0x10000) << 15) | // unused bit
-    (m_iv2 << 26) | (m_iv1 << 21) | (m_iv0 << 16) | // ivs from upper 16 bits
-    (m_otherHalfCounter & 0xffff); // lower 16 bits unknown
+  uint32_t  seed = m_ivWordSeeds[m_ivWordSeedIndex++];
   
   // back up a number of frames to account for which IVs are being generated
   // and the generation method
@@ -130,6 +301,186 @@ Gen34IVSeedGenerator::SeedType Gen34IVSeedGenerator::Next()
   return seed;
 }
 
+void Gen34IVSeedGenerator::NextIVCombination()
+{
+  if (++m_iv0 > m_iv0High)
+  {
+    m_iv0 = m_iv0Low;
+    if (++m_iv1 > m_iv1High)
+    {
+      m_iv1 = m_iv1Low;
+      if (++m_iv2 > m_iv2High)
+      {
+        m_iv2 = m_iv2Low;
+      }
+    }
+  }
+}
+
+void Gen34IVSeedGenerator::FindIVWordSeeds()
+{
+  m_ivWordSeeds.clear();
+  m_ivWordSeedIndex = 0;
+  
+  SearchIVWordSeeds(m_iv0, m_iv1, m_iv2, &m_ivWordSeeds);
+  
+  if (m_lowHalfSearch == SolveForLowHalves)
+    std::sort(m_ivWordSeeds.begin(), m_ivWordSeeds.end());
+}
+
+// find the RNG states with the IV combination in their upper 16 bits whose
+// other IV word is also in range
+uint32_t Gen34IVSeedGenerator::SearchIVWordSeeds
+  (uint32_t iv0, uint32_t iv1, uint32_t iv2,
+   std::vector<uint32_t> *seeds) const
+{
+  uint32_t  numSeeds = 0;
+  uint32_t  upperHalf = (iv2 << 26) | (iv1 << 21) | (iv0 << 16);
+  
+  for (uint32_t unusedBit = 0; unusedBit < 2; ++unusedBit)
+  {
+    uint32_t  seedHigh = (unusedBit << 31) | upperHalf;
+    uint32_t  otherWordBase = (m_otherWordMux * seedHigh) + m_otherWordInc;
+    
+    switch (m_lowHalfSearch)
+    {
+    case AllLowHalves:
+      if (seeds != 0)
+      {
+        for (uint32_t lowHalf = 0; lowHalf < 0x10000; ++lowHalf)
+          seeds->push_back(seedHigh | lowHalf);
+      }
+      numSeeds += 0x10000;
+      break;
+      
+    case ScanLowHalves:
+      {
+        const std::vector<bool>  &matches = *m_otherUpperHalfMatches;
+        uint32_t                 otherWord = otherWordBase;
+        
+        for (uint32_t lowHalf = 0; lowHalf < 0x10000; ++lowHalf)
+        {
+          if (matches[otherWord >> 16])
+          {
+            if (seeds != 0)
+              seeds->push_back(seedHigh | lowHalf);
+            ++numSeeds;
+          }
+          
+          otherWord += m_otherWordMux;
+        }
+      }
+      break;
+      
+    case SolveForLowHalves:
+      {
+        // split the low half into bytes, so that for each high byte we need
+        // mux * lowByte to land within the 64k values giving the wanted
+        // upper half, which a binary search of the sorted products finds
+        LowByteProducts::const_iterator  begin = m_lowByteProducts.begin();
+        LowByteProducts::const_iterator  end = m_lowByteProducts.end();
+        
+        const std::vector<uint32_t>  &otherUpperHalves = *m_otherUpperHalves;
+        
+        std::vector<uint32_t>::const_iterator  i;
+        for (i = otherUpperHalves.begin(); i != otherUpperHalves.end(); ++i)
+        {
+          uint32_t  wanted = (*i << 16) - otherWordBase;
+          
+          for (uint32_t highByte = 0; highByte < 0x100; ++highByte)
+          {
+            uint32_t  lowest = wanted - (m_otherWordMux * (highByte << 8));
+            
+            LowByteProducts::const_iterator  p =
+              std::lower_bound(begin, end, std::make_pair(lowest, 0U));
+            
+            // the range can wrap around past 0
+            for (uint32_t n = 0; n < 0x100; ++n, ++p)
+            {
+              if (p == end)
+                p = begin;
+              
+              if ((p->first - lowest) > 0xffff)
+                break;
+              
+              if (seeds != 0)
+                seeds->push_back(seedHigh | (highByte << 8) | p->second);
+              ++numSeeds;
+            }
+          }
+        }
+      }
+      break;
+    }
+  }
+  
+  return numSeeds;
+}
+
+
+std::list<TimeSeedGenerator> TimeSeedGenerator::Split(uint32_t parts)
+{
+  std::list<TimeSeedGenerator>  result;
+  
+  if (parts > m_numDayMonthMinuteSeconds)
+    parts = m_numDayMonthMinuteSeconds;
+  
+  uint32_t  first = 0;
+  for (uint32_t i = 0; i < parts; ++i)
+  {
+    uint32_t  next = (m_numDayMonthMinuteSeconds * (i + 1)) / parts;
+    
+    TimeSeedGenerator  part(*this);
+    part.m_dayMonthMinuteSecond = m_dayMonthMinuteSecond + (first << 24);
+    part.m_numDayMonthMinuteSeconds = next - first;
+    
+    result.push_back(part);
+    
+    first = next;
+  }
+  
+  return result;
+}
+
+
+std::list<TimeSeedBaseGenerator> TimeSeedBaseGenerator::Split(uint32_t parts)
+{
+  std::list<TimeSeedBaseGenerator>  result;
+  
+  if (parts > m_numDayMonthMinuteSeconds)
+    parts = m_numDayMonthMinuteSeconds;
+  
+  uint32_t  first = 0;
+  for (uint32_t i = 0; i < parts; ++i)
+  {
+    uint32_t  next = (m_numDayMonthMinuteSeconds * (i + 1)) / parts;
+    
+    TimeSeedBaseGenerator  part(*this);
+    part.m_dayMonthMinuteSecond = m_dayMonthMinuteSecond + (first << 24);
+    part.m_numDayMonthMinuteSeconds = next - first;
+    
+    result.push_back(part);
+    
+    first = next;
+  }
+  
+  return result;
+}
+
+
+std::list<CGearSeedGenerator> CGearSeedGenerator::Split(uint32_t parts)
+{
+  std::list<CGearSeedGenerator>  result;
+  
+  std::list<TimeSeedGenerator>  timeParts = m_timeSeedGenerator.Split(parts);
+  
+  std::list<TimeSeedGenerator>::const_iterator  i;
+  for (i = timeParts.begin(); i != timeParts.end(); ++i)
+    result.push_back(CGearSeedGenerator(m_macAddressLow, *i));
+  
+  return result;
+}
+
 
 HashedSeedGenerator::HashedSeedGenerator
   (const HashedSeedGenerator::Parameters &parameters)
@@ -137,7 +488,10 @@ HashedSeedGenerator::HashedSeedGenerator
   m_seedMessage(parameters.ToInitialSeedParameters()),
   m_timer0(parameters.timer0High), m_vcount(parameters.vcountHigh),
   m_vframe(parameters.vframeHigh),
-  m_heldButtonsIter(m_parameters.heldButtons.end() - 1)
+  m_heldButtonsIter(m_parameters.heldButtons.end() - 1),
+  m_seedTable(HashedSeedTable::Find(parameters)),
+  m_seedTableIndex(m_seedTable ? m_seedTable->SeedIndex(parameters.fromTime) :
+                                 0)
 {}
 
 HashedSeedGenerator::HashedSeedGenerator(const HashedSeedGenerator &other)
@@ -145,7 +499,8 @@ HashedSeedGenerator::HashedSeedGenerator(const HashedSeedGenerator &other)
   m_timer0(other.m_timer0), m_vcount(other.m_vcount), m_vframe(other.m_vframe),
   m_heldButtonsIter(m_parameters.heldButtons.begin() +
                     (other.m_heldButtonsIter -
-                     other.m_parameters.heldButtons.begin()))
+                     other.m_parameters.heldButtons.begin())),
+  m_seedTable(other.m_seedTable), m_seedTableIndex(other.m_seedTableIndex)
 {}
 
 HashedSeed::Parameters
@@ -220,12 +575,42 @@ HashedSeedGenerator::SeedType HashedSeedGenerator::Next()
   
   m_seedMessage.SetHeldButtons(*m_heldButtonsIter);
   
+  if (m_seedTable)
+    return HashedSeed(m_seedMessage.GetParameters(),
+                      m_seedTable->RawSeed(m_seedTableIndex++));
+  
   HashedSeed  seed = m_seedMessage.AsHashedSeed();
   
   return seed;
 }
 
 
+void HashedSeedGenerator::SetTimeRange(const ptime &fromTime,
+                                       const ptime &toTime)
+{
+  m_parameters.fromTime = fromTime;
+  m_parameters.toTime = toTime;
+  
+  // as in the constructor, start one second early on the last combination
+  // of the other parameters, so that Next moves on to fromTime
+  ptime          dt = fromTime - seconds(1);
+  time_duration  t = dt.time_of_day();
+  
+  m_seedMessage.SetDate(dt.date());
+  m_seedMessage.SetHour(t.hours());
+  m_seedMessage.SetMinute(t.minutes());
+  m_seedMessage.SetSecond(t.seconds());
+  
+  m_timer0 = m_parameters.timer0High;
+  m_vcount = m_parameters.vcountHigh;
+  m_vframe = m_parameters.vframeHigh;
+  m_heldButtonsIter = m_parameters.heldButtons.end() - 1;
+  
+  m_seedTable = HashedSeedTable::Find(m_parameters);
+  m_seedTableIndex = m_seedTable ? m_seedTable->SeedIndex(fromTime) : 0;
+}
+
+
 std::list<HashedSeedGenerator> HashedSeedGenerator::Split(uint32_t parts)
 {
   std::list<HashedSeedGenerator>  result;
@@ -239,6 +624,10 @@ std::list<HashedSeedGenerator> HashedSeedGenerator::Split(uint32_t parts)
     parts = totalSeconds;
   
   uint32_t  partSeconds = (totalSeconds + parts - 1) / parts;
+  
+  // rounding up may leave nothing for the last parts
+  parts = (totalSeconds + partSeconds - 1) / partSeconds;
+  
   seconds   delta(partSeconds);
   ptime     fromTime = m_parameters.fromTime;
   ptime     toTime = fromTime + seconds(partSeconds - 1);
@@ -253,7 +642,221 @@ std::list<HashedSeedGenerator> HashedSeedGenerator::Split(uint32_t parts)
     result.push_back(part);
     
     fromTime = fromTime + delta;
-    toTime = (i == (parts - 1)) ? m_parameters.toTime : toTime + delta;
+    toTime = (i == (parts - 2)) ? m_parameters.toTime : toTime + delta;
+  }
+  
+  return result;
+}
+
+
+
+namespace
+{
+
+bool HasSeeds(const HashedSeedGenerator::Parameters &parameters)
+{
+  return !parameters.heldButtons.empty() &&
+         (parameters.fromTime <= parameters.toTime);
+}
+
+// the clock starts from the earliest profile's message
+HashedSeed::Parameters ClockParameters
+  (const MultiProfileHashedSeedGenerator::ProfileList &profiles)
+{
+  HashedSeedGenerator::Parameters  result;
+  bool                             found = false;
+  
+  result.fromTime = result.toTime = ptime(date(2000, 1, 1));
+  
+  MultiProfileHashedSeedGenerator::ProfileList::const_iterator  i;
+  for (i = profiles.begin(); i != profiles.end(); ++i)
+  {
+    if (HasSeeds(*i) && (!found || (i->fromTime < result.fromTime)))
+    {
+      result = *i;
+      found = true;
+    }
+  }
+  
+  return result.ToInitialSeedParameters();
+}
+
+}
+
+MultiProfileHashedSeedGenerator::Profile::Profile
+  (const HashedSeedGenerator::Parameters &p)
+: parameters(p), message(p.ToInitialSeedParameters()),
+  timer0(p.timer0Low), vcount(p.vcountLow), vframe(p.vframeLow),
+  heldButtonsIndex(0), secondSeedsLeft(0)
+{}
+
+MultiProfileHashedSeedGenerator::MultiProfileHashedSeedGenerator
+  (const ProfileList &profiles)
+: m_fromTime(), m_toTime(), m_time(), m_profiles(), m_profileIndex(0),
+  m_clock(ClockParameters(profiles))
+{
+  ProfileList::const_iterator  i;
+  for (i = profiles.begin(); i != profiles.end(); ++i)
+  {
+    if (!HasSeeds(*i))
+      continue;
+    
+    if (m_profiles.empty() || (i->fromTime < m_fromTime))
+      m_fromTime = i->fromTime;
+    if (m_profiles.empty() || (i->toTime > m_toTime))
+      m_toTime = i->toTime;
+    
+    m_profiles.push_back(Profile(*i));
+  }
+  
+  // as in HashedSeedGenerator, start one second early after the last
+  // profile, so that Next moves on to the first profile at fromTime
+  m_time = m_fromTime - seconds(1);
+  m_profileIndex = m_profiles.size() - 1;
+}
+
+MultiProfileHashedSeedGenerator::SeedCountType
+  MultiProfileHashedSeedGenerator::NumberOfSeeds() const
+{
+  SeedCountType  result = 0;
+  
+  std::vector<Profile>::const_iterator  i;
+  for (i = m_profiles.begin(); i != m_profiles.end(); ++i)
+    result += i->parameters.NumberOfSeeds();
+  
+  return result;
+}
+
+MultiProfileHashedSeedGenerator::SeedType
+  MultiProfileHashedSeedGenerator::Next()
+{
+  Profile  *profile = &m_profiles[m_profileIndex];
+  
+  if (profile->secondSeedsLeft > 0)
+  {
+    NextCombination(*profile);
+  }
+  else
+  {
+    do
+    {
+      if (++m_profileIndex == m_profiles.size())
+      {
+        m_profileIndex = 0;
+        m_time = m_time + seconds(1);
+        m_clock.NextSecond();
+      }
+      
+      profile = &m_profiles[m_profileIndex];
+    }
+    while ((m_time < profile->parameters.fromTime) ||
+           (m_time > profile->parameters.toTime));
+    
+    StartSecond(*profile);
+  }
+  
+  --profile->secondSeedsLeft;
+  
+  return profile->message.AsHashedSeed();
+}
+
+void MultiProfileHashedSeedGenerator::StartSecond(Profile &profile)
+{
+  const HashedSeedGenerator::Parameters  &p = profile.parameters;
+  
+  profile.timer0 = p.timer0Low;
+  profile.vcount = p.vcountLow;
+  profile.vframe = p.vframeLow;
+  profile.heldButtonsIndex = 0;
+  
+  profile.message.SetTimer0(profile.timer0);
+  profile.message.SetVCount(profile.vcount);
+  profile.message.SetVFrame(profile.vframe);
+  profile.message.SetHeldButtons(p.heldButtons[0]);
+  profile.message.SetDateTime(m_clock);
+  
+  profile.secondSeedsLeft = SeedCountType(p.heldButtons.size()) *
+                            ((p.timer0High - p.timer0Low) + 1) *
+                            ((p.vcountHigh - p.vcountLow) + 1) *
+                            ((p.vframeHigh - p.vframeLow) + 1);
+}
+
+// same order as HashedSeedGenerator, within the current second
+void MultiProfileHashedSeedGenerator::NextCombination(Profile &profile)
+{
+  const HashedSeedGenerator::Parameters  &p = profile.parameters;
+  
+  if (++profile.heldButtonsIndex == p.heldButtons.size())
+  {
+    profile.heldButtonsIndex = 0;
+    
+    if (++profile.timer0 > p.timer0High)
+    {
+      profile.timer0 = p.timer0Low;
+      
+      if (++profile.vcount > p.vcountHigh)
+      {
+        profile.vcount = p.vcountLow;
+        
+        if (++profile.vframe > p.vframeHigh)
+          profile.vframe = p.vframeLow;
+        
+        profile.message.SetVFrame(profile.vframe);
+      }
+      
+      profile.message.SetVCount(profile.vcount);
+    }
+    
+    profile.message.SetTimer0(profile.timer0);
+  }
+  
+  profile.message.SetHeldButtons(p.heldButtons[profile.heldButtonsIndex]);
+}
+
+std::list<MultiProfileHashedSeedGenerator>
+  MultiProfileHashedSeedGenerator::Split(uint32_t parts)
+{
+  std::list<MultiProfileHashedSeedGenerator>  result;
+  
+  if (m_profiles.empty())
+  {
+    result.push_back(*this);
+    return result;
+  }
+  
+  uint32_t  totalSeconds = (m_toTime - m_fromTime).total_seconds() + 1;
+  
+  if (parts > totalSeconds)
+    parts = totalSeconds;
+  
+  uint32_t  partSeconds = (totalSeconds + parts - 1) / parts;
+  ptime     fromTime = m_fromTime;
+  
+  while (fromTime <= m_toTime)
+  {
+    ptime  toTime = fromTime + seconds(partSeconds - 1);
+    if (toTime > m_toTime)
+      toTime = m_toTime;
+    
+    ProfileList  partProfiles;
+    
+    std::vector<Profile>::const_iterator  i;
+    for (i = m_profiles.begin(); i != m_profiles.end(); ++i)
+    {
+      HashedSeedGenerator::Parameters  p = i->parameters;
+      
+      p.fromTime = std::max(p.fromTime, fromTime);
+      p.toTime = std::min(p.toTime, toTime);
+      
+      if (p.fromTime <= p.toTime)
+        partProfiles.push_back(p);
+    }
+    
+    // gaps between the profiles' times leave some parts empty
+    if (!partProfiles.empty())
+      result.push_back(MultiProfileHashedSeedGenerator(partProfiles));
+    
+    fromTime = toTime + seconds(1);
   }
   
   return result;
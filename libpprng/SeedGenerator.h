@@ -27,10 +27,13 @@
 #include <list>
 #include <vector>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/shared_ptr.hpp>
 
 namespace pprng
 {
 
+class HashedSeedTable;
+
 class Gen34IVSeedGenerator
 {
 public:
@@ -45,14 +48,62 @@ public:
   
   SeedType Next();
   
+  // each part takes a run of the iterated IV word's combinations
+  std::list<Gen34IVSeedGenerator>  Split(uint32_t parts);
+  
 private:
+  uint32_t NumberOfIVCombinations() const;
+  void GetIVCombination(uint32_t index,
+                        uint32_t &iv0, uint32_t &iv1, uint32_t &iv2) const;
+  void SetIVCombinationRange(uint32_t first, uint32_t count);
+  void NextIVCombination();
+  void FindIVWordSeeds();
+  
+  // appends an IV combination's seeds to seeds, if not null, and returns how
+  // many there are
+  uint32_t SearchIVWordSeeds(uint32_t iv0, uint32_t iv1, uint32_t iv2,
+                             std::vector<uint32_t> *seeds) const;
+  
+  // how the unknown lower 16 bits are found for each iterated IV word
+  enum LowHalfSearch
+  {
+    AllLowHalves,        // other IVs unconstrained, or too costly to check
+    ScanLowHalves,       // step through the low halves, checking the other IVs
+    SolveForLowHalves    // solve for the low halves giving each other IV word
+  };
+  
   const IVs       m_minIVs, m_maxIVs;
   const uint32_t  m_method;
   const bool      m_iteratingHpAtDef;
   const uint32_t  m_numRollbacks;
   uint32_t        m_iv0, m_iv1, m_iv2;
   uint32_t        m_iv0Low, m_iv0High, m_iv1Low, m_iv1High, m_iv2Low, m_iv2High;
-  uint32_t        m_otherHalfCounter;
+  
+  // the RNG state holding the other IV word is (mux * seed) + inc
+  uint32_t        m_otherWordMux, m_otherWordInc;
+  
+  LowHalfSearch          m_lowHalfSearch;
+  
+  // never changed after construction, so shared by Split parts
+  typedef boost::shared_ptr<const std::vector<uint32_t> >  SharedUInt32s;
+  typedef boost::shared_ptr<const std::vector<bool> >      SharedBools;
+  
+  SharedUInt32s          m_otherUpperHalves;
+  SharedBools            m_otherUpperHalfMatches;
+  
+  // (mux * lowByte, lowByte) pairs sorted by product, for SolveForLowHalves
+  typedef std::vector<std::pair<uint32_t, uint32_t> >  LowByteProducts;
+  LowByteProducts        m_lowByteProducts;
+  
+  std::vector<uint32_t>  m_ivWordSeeds;
+  uint32_t               m_ivWordSeedIndex;
+  
+  // unless using AllLowHalves, counting the seeds means finding them, so it
+  // waits for NumberOfSeeds, which SearchRunner calls on each Split part in
+  // its own thread
+  uint32_t               m_firstIVCombination, m_numIVCombinations;
+  mutable bool           m_numSeedsCounted;
+  mutable SeedCountType  m_numSeeds;
 };
 
 class TimeSeedGenerator
@@ -65,13 +116,14 @@ public:
   
   TimeSeedGenerator(uint32_t minDelay, uint32_t maxDelay)
     : m_minDelay(minDelay), m_maxDelay(maxDelay & 0xffff),
+      m_numDayMonthMinuteSeconds(256),
       m_dayMonthMinuteSecond(0xff000000), m_hour(0x00170000),
       m_delay(maxDelay)
   {}
   
   SeedCountType NumberOfSeeds() const
   {
-    return 256 * 24 * (m_maxDelay - m_minDelay + 1);
+    return m_numDayMonthMinuteSeconds * 24 * (m_maxDelay - m_minDelay + 1);
   }
   
   SeedType Next()
@@ -91,21 +143,62 @@ public:
     return m_dayMonthMinuteSecond | m_hour | m_delay;
   }
   
-  std::list<TimeSeedGenerator>  Split(uint32_t parts)
-  {
-    return std::list<TimeSeedGenerator>();
-  }
+  // each part takes a run of the month * day + minute + second byte values
+  std::list<TimeSeedGenerator>  Split(uint32_t parts);
   
 private:
   const uint32_t  m_minDelay;
   const uint32_t  m_maxDelay;
   
+  uint32_t  m_numDayMonthMinuteSeconds;
   uint32_t  m_dayMonthMinuteSecond;
   uint32_t  m_hour;
   uint32_t  m_delay;
 };
 
 
+// generates the month/day/minute/second and hour parts of every time seed,
+// leaving the delay for the seed searcher to fill in
+class TimeSeedBaseGenerator
+{
+public:
+  typedef uint32_t  SeedType;
+  typedef uint32_t  SeedCountType;
+  
+  enum { SeedsPerChunk = 1000 };
+  
+  TimeSeedBaseGenerator()
+    : m_numDayMonthMinuteSeconds(256),
+      m_dayMonthMinuteSecond(0xff000000), m_hour(0x00170000)
+  {}
+  
+  SeedCountType NumberOfSeeds() const
+  {
+    return m_numDayMonthMinuteSeconds * 24;
+  }
+  
+  SeedType Next()
+  {
+    m_hour += 0x00010000;
+    
+    if (m_hour > 0x00170000)
+    {
+      m_hour = 0x00000000;
+      m_dayMonthMinuteSecond += 0x01000000;
+    }
+    
+    return m_dayMonthMinuteSecond | m_hour;
+  }
+  
+  std::list<TimeSeedBaseGenerator>  Split(uint32_t parts);
+  
+private:
+  uint32_t  m_numDayMonthMinuteSeconds;
+  uint32_t  m_dayMonthMinuteSecond;
+  uint32_t  m_hour;
+};
+
+
 class CGearSeedGenerator
 {
 public:
@@ -131,12 +224,14 @@ public:
     return result + m_macAddressLow;
   }
   
-  std::list<CGearSeedGenerator>  Split(uint32_t parts)
-  {
-    return std::list<CGearSeedGenerator>();
-  }
+  std::list<CGearSeedGenerator>  Split(uint32_t parts);
   
 private:
+  CGearSeedGenerator(uint32_t macAddressLow,
+                     const TimeSeedGenerator &timeSeedGenerator)
+    : m_macAddressLow(macAddressLow), m_timeSeedGenerator(timeSeedGenerator)
+  {}
+  
   const uint32_t  m_macAddressLow;
   
   TimeSeedGenerator  m_timeSeedGenerator;
@@ -161,9 +256,9 @@ public:
     Button::List              heldButtons;
     
     Parameters()
-      : version(Game::Version(0)), macAddress(0), timer0Low(0), timer0High(0),
-        vcountLow(0), vcountHigh(0), vframeLow(0), vframeHigh(0),
-        fromTime(), toTime(), heldButtons()
+      : version(Game::Version(0)), dsType(DS::Type(0)), macAddress(0),
+        timer0Low(0), timer0High(0), vcountLow(0), vcountHigh(0),
+        vframeLow(0), vframeHigh(0), fromTime(), toTime(), heldButtons()
     {}
     
     HashedSeed::Parameters ToInitialSeedParameters() const;
@@ -183,13 +278,67 @@ public:
   
   std::list<HashedSeedGenerator>  Split(uint32_t parts);
   
+  // restarts generation over a new range of times
+  void SetTimeRange(const boost::posix_time::ptime &fromTime,
+                    const boost::posix_time::ptime &toTime);
+  
 private:
-  const HashedSeedGenerator::Parameters  m_parameters;
+  HashedSeedGenerator::Parameters        m_parameters;
   
   HashedSeedMessage                      m_seedMessage;
   
   uint32_t                               m_timer0, m_vcount, m_vframe;
   Button::List::const_iterator           m_heldButtonsIter;
+  
+  // raw seeds are read from a loaded table instead, if it covers these times
+  boost::shared_ptr<const HashedSeedTable>  m_seedTable;
+  uint64_t                                  m_seedTableIndex;
+};
+
+
+// Generates the seeds of several sets of parameters, such as those of
+// different DSs or games, a second at a time.  The date and time message
+// words are worked out once per second and copied into each set's message.
+class MultiProfileHashedSeedGenerator
+{
+public:
+  typedef HashedSeed  SeedType;
+  typedef uint64_t    SeedCountType;
+  
+  typedef std::vector<HashedSeedGenerator::Parameters>  ProfileList;
+  
+  enum { SeedsPerChunk = 50000 };
+  
+  MultiProfileHashedSeedGenerator(const ProfileList &profiles);
+  
+  SeedCountType NumberOfSeeds() const;
+  
+  SeedType Next();
+  
+  // each part takes a run of the seconds, and the profiles covering them
+  std::list<MultiProfileHashedSeedGenerator>  Split(uint32_t parts);
+  
+private:
+  struct Profile
+  {
+    Profile(const HashedSeedGenerator::Parameters &p);
+    
+    HashedSeedGenerator::Parameters  parameters;
+    HashedSeedMessage                message;
+    uint32_t                         timer0, vcount, vframe;
+    uint32_t                         heldButtonsIndex;
+    SeedCountType                    secondSeedsLeft;
+  };
+  
+  void StartSecond(Profile &profile);
+  void NextCombination(Profile &profile);
+  
+  boost::posix_time::ptime  m_fromTime, m_toTime, m_time;
+  std::vector<Profile>      m_profiles;
+  uint32_t                  m_profileIndex;
+  
+  // holds the current date and time words for all the profiles
+  HashedSeedMessage         m_clock;
 };
 
 }
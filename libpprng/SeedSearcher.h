@@ -24,12 +24,14 @@
 #include "PPRNGTypes.h"
 #include "SearchCriteria.h"
 #include "FrameSearcher.h"
-#include <boost/function.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <sstream>
 
 namespace pprng
 {
 
+// The factory returns a newly allocated frame generator, which is then reused
+// for every following seed via FrameGenerator::Reseed.
 template <class FrameGeneratorFactory>
 class SeedFrameSearcher
 {
@@ -39,27 +41,39 @@ public:
   typedef typename FrameGenerator::Frame                  Frame;
   typedef Frame                                           ResultType;
   
-  typedef boost::function<void (const Frame&)> ResultCallback;
-  
   SeedFrameSearcher(const FrameGeneratorFactory &frameGeneratorFactory,
                     const SearchCriteria::FrameRange &frameRange)
-    : m_frameGeneratorFactory(frameGeneratorFactory), m_frameRange(frameRange)
+    : m_frameGeneratorFactory(frameGeneratorFactory), m_frameRange(frameRange),
+      m_frameGenerator()
+  {}
+  
+  // copies don't share a frame generator, so each thread can have its own
+  SeedFrameSearcher(const SeedFrameSearcher &other)
+    : m_frameGeneratorFactory(other.m_frameGeneratorFactory),
+      m_frameRange(other.m_frameRange), m_frameGenerator()
   {}
   
-  template <class FrameChecker>
+  template <class FrameChecker, class ResultCallback>
   void Search(const Seed &seed, const FrameChecker &frameChecker,
               const ResultCallback &resultHandler)
   {
-    FrameGenerator     frameGenerator = m_frameGeneratorFactory(seed);
-    FrameSearcher<FrameGenerator>  frameSearcher(frameGenerator);
+    if (m_frameGenerator)
+      m_frameGenerator->Reseed(seed);
+    else
+      m_frameGenerator.reset(m_frameGeneratorFactory(seed));
+    
+    FrameSearcher<FrameGenerator>  frameSearcher(*m_frameGenerator);
     
     while(frameSearcher.Search(m_frameRange, frameChecker, resultHandler))
       /* search all frames, not just first */;
   }
   
 private:
-  const FrameGeneratorFactory       &m_frameGeneratorFactory;
-  const SearchCriteria::FrameRange  &m_frameRange;
+  SeedFrameSearcher& operator=(const SeedFrameSearcher&);
+  
+  const FrameGeneratorFactory        &m_frameGeneratorFactory;
+  const SearchCriteria::FrameRange   &m_frameRange;
+  boost::scoped_ptr<FrameGenerator>  m_frameGenerator;
 };
 
 }
@@ -29,53 +29,65 @@ namespace pprng
 
 TimeSeed::TimeElements
 TimeSeed::GetTimeElements(uint32_t year, uint32_t wantedSecond) const
+{
+  TimeConstraints  constraints;
+  
+  if (wantedSecond < 60)
+    constraints.seconds = 1ULL << wantedSecond;
+  
+  return GetTimeElements(year, constraints);
+}
+
+TimeSeed::TimeElements
+TimeSeed::GetTimeElements(uint32_t year,
+                          const TimeConstraints &constraints) const
 {
   TimeElements  result;
   
   uint32_t  seedMoDayMinSec = (m_seed >> 24) & 0xff;
   uint32_t  hour = Hour();
   uint32_t  delay = BaseDelay() - (year - 2000);
-  uint32_t  startSecond, endSecond;
-  
-  if (wantedSecond < 60)
-  {
-    startSecond = endSecond = wantedSecond;
-  }
-  else
-  {
-    startSecond = 0;
-    endSecond = 59;
-  }
   
   for (uint32_t month = 1; month <= 12; ++month)
   {
-    date  d(year, month, 1);
+    if ((constraints.months & (1U << month)) == 0)
+      continue;
     
-    uint32_t  lastDay = d.end_of_month().day();
+    uint32_t  lastDay = gregorian_calendar::end_of_month_day(year, month);
     
     for (uint32_t day = 1; day <= lastDay; ++day)
     {
-      for (uint32_t minute = 0; minute < 60; ++minute)
+      if ((constraints.days & (1U << day)) == 0)
+        continue;
+      
+      // minute + second is at most 118, so it can only be the low byte
+      // itself
+      uint32_t  minSec = (seedMoDayMinSec - (month * day)) & 0xff;
+      if (minSec > 118)
+        continue;
+      
+      uint32_t  minute = (minSec > 59) ? (minSec - 59) : 0;
+      uint32_t  lastMinute = (minSec < 59) ? minSec : 59;
+      
+      for (; minute <= lastMinute; ++minute)
       {
-        for (uint32_t second = startSecond; second <= endSecond; ++second)
-        {
-          uint32_t  moDayMinSec = ((month * day) + minute + second) & 0xff;
-          
-          if (seedMoDayMinSec == moDayMinSec)
-          {
-            TimeElement  element;
-            
-            element.year = year;
-            element.month = month;
-            element.day = day;
-            element.hour = hour;
-            element.minute = minute;
-            element.second = second;
-            element.delay = delay;
-            
-            result.push_back(element);
-          }
-        }
+        uint32_t  second = minSec - minute;
+        
+        if (((constraints.minutes & (1ULL << minute)) == 0) ||
+            ((constraints.seconds & (1ULL << second)) == 0))
+          continue;
+        
+        TimeElement  element;
+        
+        element.year = year;
+        element.month = month;
+        element.day = day;
+        element.hour = hour;
+        element.minute = minute;
+        element.second = second;
+        element.delay = delay;
+        
+        result.push_back(element);
       }
     }
   }
@@ -41,6 +41,21 @@ struct TimeSeed
   };
   typedef std::list<TimeElement>  TimeElements;
   
+  // bit sets of the calendar values a time element may take, such as
+  // (1 << month) for months 1 - 12 or (1ULL << second) for seconds 0 - 59
+  struct TimeConstraints
+  {
+    uint32_t  months;
+    uint32_t  days;
+    uint64_t  minutes;
+    uint64_t  seconds;
+    
+    TimeConstraints()
+      : months(0x1ffe), days(0xfffffffe),
+        minutes(0x0fffffffffffffffULL), seconds(0x0fffffffffffffffULL)
+    {}
+  };
+  
   TimeSeed(uint32_t seed)
     : m_seed(seed)
   {}
@@ -65,6 +80,8 @@ struct TimeSeed
   }
   
   TimeElements GetTimeElements(uint32_t year, uint32_t second = -1) const;
+  TimeElements GetTimeElements(uint32_t year,
+                               const TimeConstraints &constraints) const;
   
   uint32_t  m_seed;
 };
@@ -57,9 +57,9 @@ struct FrameGeneratorFactory
     : m_ShinyPID(shinyPID)
   {}
   
-  Gen5TrainerIDFrameGenerator operator()(const HashedSeed &seed) const
+  Gen5TrainerIDFrameGenerator* operator()(const HashedSeed &seed) const
   {
-    return Gen5TrainerIDFrameGenerator(seed, m_ShinyPID);
+    return new Gen5TrainerIDFrameGenerator(seed, m_ShinyPID);
   }
   
   const PID m_ShinyPID;
@@ -95,8 +95,8 @@ void TrainerIDSearcher::Search
   
   SearchRunner  searcher;
   
-  searcher.Search(seedGenerator, seedSearcher, frameChecker,
-                  resultHandler, progressHandler);
+  searcher.SearchThreaded(seedGenerator, seedSearcher, frameChecker,
+                          resultHandler, progressHandler);
 }
 
 }
@@ -54,7 +54,8 @@ public:
   };
   
   typedef Gen5TrainerIDFrameGenerator::Frame         ResultType;
-  typedef boost::function<void (const ResultType&)>  ResultCallback;
+  typedef boost::function<void (const ResultType*, std::size_t)>
+                                                     ResultCallback;
   
   TrainerIDSearcher() {}
   
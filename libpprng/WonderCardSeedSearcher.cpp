@@ -90,9 +90,9 @@ struct FrameGeneratorFactory
     : m_criteria(criteria)
   {}
   
-  WonderCardFrameGenerator operator()(const HashedSeed &seed) const
+  WonderCardFrameGenerator* operator()(const HashedSeed &seed) const
   {
-    return WonderCardFrameGenerator(seed, m_criteria.frameParameters);
+    return new WonderCardFrameGenerator(seed, m_criteria.frameParameters);
   }
   
   const WonderCardSeedSearcher::Criteria  &m_criteria;
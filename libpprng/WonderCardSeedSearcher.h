@@ -53,7 +53,8 @@ public:
   };
   
   typedef WonderCardFrameGenerator::Frame            ResultType;
-  typedef boost::function<void (const ResultType&)>  ResultCallback;
+  typedef boost::function<void (const ResultType*, std::size_t)>
+                                                     ResultCallback;
   
   WonderCardSeedSearcher() {}
   
@@ -22,6 +22,7 @@
 #import "AppDelegate.h"
 
 #include "EggSeedSearcher.h"
+#include "HashedSeedTable.h"
 
 #import "Gen5ConfigurationController.h"
 
@@ -200,6 +201,28 @@
   
   pprng::EggSeedSearcher::SetCacheDirectory([appPath UTF8String]);
   
+  // any egg seed cache written in an earlier run
+  NSUserDefaults  *defaults = [NSUserDefaults standardUserDefaults];
+  NSInteger       firstCacheFrame =
+    [defaults integerForKey: @"eggSeedCacheFirstFrame"];
+  NSInteger       lastCacheFrame =
+    [defaults integerForKey: @"eggSeedCacheLastFrame"];
+  
+  if (firstCacheFrame > 0)
+    pprng::EggSeedSearcher::SetCacheFrames(firstCacheFrame, lastCacheFrame);
+  
+  // any table written in an earlier run
+  pprng::HashedSeedTable::SetTableDirectory([appPath UTF8String]);
+  pprng::HashedSeedTable::Load(pprng::HashedSeedTable::TableFilePath());
+  
+  // handled by the Gen 5 IV and egg seed searchers while their windows are key
+  NSMenu  *fileMenu = [[[NSApp mainMenu] itemWithTitle: @"File"] submenu];
+  [fileMenu addItem: [NSMenuItem separatorItem]];
+  [fileMenu addItemWithTitle: @"Write Seed Table"
+            action: @selector(writeSeedTable:) keyEquivalent: @""];
+  [fileMenu addItemWithTitle: @"Write Egg Seed Cache"
+            action: @selector(writeSeedCache:) keyEquivalent: @""];
+  
   launcherController = [[LauncherController alloc] init];
   [launcherController showWindow:self];
   [self performSelectorInBackground:@selector(checkVersion) withObject:nil];
@@ -211,6 +234,7 @@
   [[NSApp windows] makeObjectsPerformSelector: @selector(close)];
   
   pprng::EggSeedSearcher::EnsureSeedCacheReleased();
+  pprng::HashedSeedTable::Release();
 }
 
 @end
@@ -23,6 +23,8 @@
 #import "VertResizeOnlyWindowController.h"
 #import "Gen5ConfigurationController.h"
 #import "SearcherController.h"
+#include "InitialSeedSearcher.h"
+#include <boost/scoped_ptr.hpp>
 
 @interface B2W2ParameterSearcherController : VertResizeOnlyWindowController
 {
@@ -39,6 +41,8 @@
   uint64_t  spinnerSequenceSearchValue;
   
   IBOutlet SearcherController     *searcherController;
+  
+  boost::scoped_ptr<pprng::IncrementalB2W2InitialSeedSearcher>  searcher;
 }
 
 @property uint32_t  timer0Low, timer0High;
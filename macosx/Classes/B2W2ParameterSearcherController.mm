@@ -182,6 +182,9 @@ struct ProgressHandler
   self.button3 = 0;
   
   self.spinnerSequenceSearchValue = 0;
+  
+  // keeps the last search's seeds, so that added spins only check those
+  searcher.reset(new IncrementalB2W2InitialSeedSearcher());
 }
 
 - (void)windowWillClose:(NSNotification *)notification
@@ -333,11 +336,11 @@ struct ProgressHandler
     criteria(static_cast<B2W2InitialSeedSearcher::Criteria*>
                ([criteriaPtr pointerValue]));
   
-  B2W2InitialSeedSearcher  searcher;
-  
-  searcher.Search(*criteria,
-                  ResultHandler(searcherController, criteria->memoryLinkUsed),
-                  ProgressHandler(searcherController));
+  searcher->Search(*criteria,
+                   ForEachResult<B2W2InitialSeedSearcher::ResultType>
+                     (ResultHandler(searcherController,
+                                    criteria->memoryLinkUsed)),
+                   ProgressHandler(searcherController));
 }
 
 @end
@@ -26,6 +26,7 @@
 #import "StandardSeedInspectorController.h"
 
 #include "CGearNatureSearcher.h"
+#include "AdjacentSeedGenerator.h"
 #include "FrameGenerator.h"
 #include "Utilities.h"
 
@@ -409,65 +410,49 @@ struct ProgressHandler
   
   [adjacentsContentArray setContent: [NSMutableArray array]];
   
-  uint32_t   macAddressLow = [gen5ConfigController macAddressLow];
+  CGearAdjacentSeedGenerator::Criteria  criteria;
   
-  uint32_t  targetDelay = seedTime.delay;
-  uint32_t  endDelay = targetDelay + adjacentsDelayVariance;
-  uint32_t  startDelay = (targetDelay < adjacentsDelayVariance) ? 0 :
-                           targetDelay - adjacentsDelayVariance;
+  criteria.targetTime =
+    UInt32DateAndTimeToBoostTime(seedTime.date, seedTime.time);
+  criteria.targetDelay = seedTime.delay;
+  criteria.macAddressLow = [gen5ConfigController macAddressLow];
+  criteria.secondsVariance = adjacentsTimeVariance;
+  criteria.delayVariance = adjacentsDelayVariance;
+  criteria.ivFrame = SearchCriteria::FrameRange(adjacentsMinIVFrame,
+                                                adjacentsMaxIVFrame);
+  criteria.ivFrameType = adjacentsIVParameterController.isRoamer ?
+                           CGearIVFrameGenerator::Roamer :
+                           CGearIVFrameGenerator::Normal;
   
-  ptime  targetTime(UInt32DateAndTimeToBoostTime(seedTime.date, seedTime.time));
-  
-  ptime  endTime = targetTime + seconds(adjacentsTimeVariance);
-  targetTime = targetTime - seconds(adjacentsTimeVariance);
+  CGearAdjacentSeedGenerator::Results  adjacents =
+    CGearAdjacentSeedGenerator::Generate(criteria);
   
   NSMutableArray  *rowArray =
     [NSMutableArray arrayWithCapacity:
-      ((2 * adjacentsDelayVariance) + 1) * ((2 * adjacentsTimeVariance) + 1)];
+      adjacents.size() * (adjacentsMaxIVFrame - adjacentsMinIVFrame + 1)];
   
-  for (; targetTime <= endTime; targetTime = targetTime + seconds(1))
+  CGearAdjacentSeedGenerator::Results::const_iterator  i;
+  for (i = adjacents.begin(); i != adjacents.end(); ++i)
   {
-    uint32_t  dt = MakeUInt32Date(targetTime.date());
-    uint32_t  yr = GetUInt32DateYear(dt);
-    uint32_t  mo = GetUInt32DateMonth(dt);
-    uint32_t  dy = GetUInt32DateDay(dt);
-    
-    uint32_t  tm = MakeUInt32Time(targetTime.time_of_day());
-    uint32_t  hr = GetUInt32TimeHour(tm);
-    uint32_t  mi = GetUInt32TimeMinute(tm);
-    uint32_t  sc = GetUInt32TimeSecond(tm);
+    uint32_t  dt = MakeUInt32Date(i->time.date());
+    uint32_t  tm = MakeUInt32Time(i->time.time_of_day());
+    uint32_t  f = (criteria.ivFrame.min > 0) ? criteria.ivFrame.min : 1;
     
-    for (uint32_t delay = startDelay; delay <= endDelay; ++delay)
+    std::vector<IVs>::const_iterator  ivs;
+    for (ivs = i->ivs.begin(); ivs != i->ivs.end(); ++ivs, ++f)
     {
-      CGearSeed  s(yr, mo, dy, hr, mi, sc, delay, macAddressLow);
+      CGearAdjacentSeedResult  *row = [[CGearAdjacentSeedResult alloc] init];
       
-      CGearIVFrameGenerator  ivGenerator
-        (s.m_rawSeed, (adjacentsIVParameterController.isRoamer ?
-                        CGearIVFrameGenerator::Roamer :
-                        CGearIVFrameGenerator::Normal));
-      uint32_t   f;
-      for (f = 0; f < (adjacentsMinIVFrame - 1); ++f)
-        ivGenerator.AdvanceFrame();
+      row.seed = i->seed.m_rawSeed;
+      row.date = dt;
+      row.time = tm;
+      row.delay = i->delay;
+      row.frame = f;
       
-      while (f++ < adjacentsMaxIVFrame)
-      {
-        ivGenerator.AdvanceFrame();
-        
-        CGearAdjacentSeedResult  *row = [[CGearAdjacentSeedResult alloc] init];
-        
-        row.seed = s.m_rawSeed;
-        row.date = dt;
-        row.time = tm;
-        row.delay = delay;
-        row.frame = f;
-        
-        IVs  ivs = ivGenerator.CurrentFrame().ivs;
-        
-        SetIVResult(row, ivs, adjacentsIVParameterController.isRoamer);
-        row.ivWord = ivs.word;
-        
-        [rowArray addObject: row];
-      }
+      SetIVResult(row, *ivs, adjacentsIVParameterController.isRoamer);
+      row.ivWord = ivs->word;
+      
+      [rowArray addObject: row];
     }
   }
   
@@ -611,8 +596,10 @@ struct ProgressHandler
   CGearNatureSearcher  searcher;
   
   searcher.Search(*criteria,
-                  ResultHandler(searcherController,
-                                (criteria->pid.gender == Gender::GENDERLESS)),
+                  ForEachResult<CGearNatureSearcher::ResultType>
+                    (ResultHandler(searcherController,
+                                   (criteria->pid.gender ==
+                                    Gender::GENDERLESS))),
                   ProgressHandler(searcherController));
 }
 
@@ -221,9 +221,10 @@ struct ProgressHandler
   CGearSeedSearcher  searcher;
   
   searcher.Search(*criteria,
-                  ResultHandler(searcherController,
-                                criteria->macAddressLow,
-                                criteria->ivs.isRoamer),
+                  ForEachResult<CGearSeedSearcher::ResultType>
+                    (ResultHandler(searcherController,
+                                   criteria->macAddressLow,
+                                   criteria->ivs.isRoamer)),
                   ProgressHandler(searcherController));
 }
 
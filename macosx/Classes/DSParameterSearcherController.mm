@@ -263,7 +263,8 @@ struct ProgressHandler
   InitialIVSeedSearcher  searcher;
   
   searcher.Search(*criteria,
-                  ResultHandler(searcherController, criteria->isRoamer),
+                  ForEachResult<InitialIVSeedSearcher::ResultType>
+                    (ResultHandler(searcherController, criteria->isRoamer)),
                   ProgressHandler(searcherController));
 }
 
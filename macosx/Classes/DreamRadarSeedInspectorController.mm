@@ -23,6 +23,7 @@
 #import "DreamRadarSeedInspectorController.h"
 
 #include "HashedSeed.h"
+#include "AdjacentSeedGenerator.h"
 #include "FrameGenerator.h"
 #include "Utilities.h"
 
@@ -329,57 +330,34 @@ SYNTHESIZE_HASHED_SEED_RESULT_PARAMETERS_PROPERTIES();
   targetSeedParams.second = [startSecond unsignedIntValue];
   targetSeedParams.heldButtons = button1 | button2 | button3;
   
-  uint32_t  timer0Low = targetSeedParams.timer0 - timer0Variance;
-  uint32_t  timer0High = targetSeedParams.timer0 + timer0Variance;
+  HashedAdjacentSeedGenerator::Criteria  criteria;
   
-  if (targetSeedParams.timer0 < timer0Variance)
-  {
-    timer0Low = 0;
-  }
-  if (targetSeedParams.timer0 > (0xffffffff - timer0Variance))
-  {
-    timer0High = 0xffffffff;
-  }
+  criteria.targetSeed = targetSeedParams;
+  criteria.secondsVariance = secondsVariance;
+  criteria.timer0Variance = timer0Variance;
   
-  ptime  seedTime(targetSeedParams.date, hours(targetSeedParams.hour) +
-                                         minutes(targetSeedParams.minute) +
-                                         seconds(targetSeedParams.second));
-  ptime  dt = seedTime;
-  ptime  endTime = dt + seconds(secondsVariance);
-  dt = dt - seconds(secondsVariance);
+  // only the seeds are needed, the spinner is worked out for each below
+  criteria.ivFrame.max = 0;
+  criteria.pidFrame.max = 0;
   
-  HashedSeed::Parameters  seedParams = targetSeedParams;
+  HashedAdjacentSeedGenerator::Results  adjacents =
+    HashedAdjacentSeedGenerator::Generate(criteria);
   
   NSMutableArray  *rowArray =
-    [NSMutableArray arrayWithCapacity:
-      (timer0High - timer0Low + 1) * ((2 * secondsVariance) + 1)];
+    [NSMutableArray arrayWithCapacity: adjacents.size()];
   
-  for (; dt <= endTime; dt = dt + seconds(1))
+  HashedAdjacentSeedGenerator::Results::const_iterator  i;
+  for (i = adjacents.begin(); i != adjacents.end(); ++i)
   {
-    seedParams.date = dt.date();
+    DreamRadarSeedInspectorAdjacentFrame  *row =
+      [[DreamRadarSeedInspectorAdjacentFrame alloc] init];
     
-    time_duration  t = dt.time_of_day();
+    SetHashedSeedResultParameters(row, i->seed);
     
-    seedParams.hour = t.hours();
-    seedParams.minute = t.minutes();
-    seedParams.second = t.seconds();
+    row.spinnerSequence = SpinnerPositions(i->seed, memoryLinkUsed,
+                                           SpinnerPositions::MAX_SPINS).word;
     
-    for (uint32_t t0 = timer0Low; t0 <= timer0High; ++t0)
-    {
-      seedParams.timer0 = t0;
-      
-      HashedSeed  seed(seedParams);
-      
-      DreamRadarSeedInspectorAdjacentFrame  *row =
-        [[DreamRadarSeedInspectorAdjacentFrame alloc] init];
-      
-      SetHashedSeedResultParameters(row, seed);
-      
-      row.spinnerSequence = SpinnerPositions(seed, memoryLinkUsed,
-                                             SpinnerPositions::MAX_SPINS).word;
-      
-      [rowArray addObject: row];
-    }
+    [rowArray addObject: row];
   }
   
   [adjacentsContentArray addObjects: rowArray];
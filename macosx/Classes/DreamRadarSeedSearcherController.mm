@@ -411,7 +411,8 @@ struct ProgressHandler
   
   searcher.Search
     (*criteria,
-     ResultHandler(searcherController, *criteria),
+     ForEachResult<DreamRadarSeedSearcher::ResultType>
+       (ResultHandler(searcherController, *criteria)),
      ProgressHandler(searcherController));
 }
 
@@ -92,4 +92,6 @@ NSNumber  *maleHP, *maleAT, *maleDF, *maleSA, *maleSD, *maleSP;
 
 - (IBAction)toggleDropDownChoice:(id)sender;
 
+- (IBAction)writeSeedCache:(id)sender;
+
 @end
@@ -112,7 +112,23 @@ struct ResultHandler
     : controller(co), m_criteria(cr)
   {}
   
-  void operator()(const Gen5EggFrame &frame)
+  void operator()(const Gen5EggFrame *frames, std::size_t numFrames)
+  {
+    std::vector<uint64_t>                      rawSeeds(numFrames);
+    std::vector<HashedSeed::SkippedPIDFrames>  skippedFrames(numFrames);
+    
+    for (std::size_t i = 0; i < numFrames; ++i)
+      rawSeeds[i] = frames[i].seed.rawSeed;
+    
+    HashedSeed::CalculateSkippedPIDFrames(&rawSeeds[0], numFrames,
+                                          m_criteria.seedParameters.version,
+                                          false, &skippedFrames[0]);
+    
+    for (std::size_t i = 0; i < numFrames; ++i)
+      AddFrame(frames[i], skippedFrames[i].count);
+  }
+  
+  void AddFrame(const Gen5EggFrame &frame, uint32_t skippedFrames)
   {
     EggSeedSearchResult  *result = [[EggSeedSearchResult alloc] init];
     
@@ -126,7 +142,7 @@ struct ResultHandler
     result.usingEverstone = m_criteria.frameParameters.usingEverstone;
     result.usingDitto = m_criteria.frameParameters.usingDitto;
     
-    result.startFrame = frame.seed.GetSkippedPIDFrames(false) + 1;
+    result.startFrame = skippedFrames + 1;
     result.pidFrame = frame.number;
     
     SetPIDResult(result, frame.pid,
@@ -580,6 +596,66 @@ struct ProgressHandler
   }
 }
 
+// sent through the responder chain by the File menu's Write Egg Seed Cache
+// item, caching the IV frames currently searched
+- (IBAction)writeSeedCache:(id)sender
+{
+  if ([searcherController isSearching] || !EndEditing([self window]))
+    return;
+  
+  if (minIVFrame > maxIVFrame)
+  {
+    NSAlert *alert = [[NSAlert alloc] init];
+    
+    [alert addButtonWithTitle:@"OK"];
+    [alert setMessageText: @"Invalid IV Frame Range"];
+    [alert setInformativeText: @"The minimum IV frame must not be greater than the maximum IV frame."];
+    [alert setAlertStyle:NSWarningAlertStyle];
+    
+    [alert beginSheetModalForWindow: [self window] modalDelegate: self
+           didEndSelector: @selector(alertDidEnd:returnCode:contextInfo:)
+           contextInfo: nil];
+    return;
+  }
+  
+  uint32_t  offset =
+    EggSeedSearcher::CacheFrameOffset([gen5ConfigController version]);
+  
+  [searcherController
+    startBackgroundTask: @selector(doWriteSeedCacheForFrames:)
+    withObject: [NSValue valueWithPointer:
+                  new SearchCriteria::FrameRange(minIVFrame + offset,
+                                                 maxIVFrame + offset)]];
+}
+
+- (void)doWriteSeedCacheForFrames:(NSValue*)framesPtr
+{
+  std::auto_ptr<SearchCriteria::FrameRange>
+    frames(static_cast<SearchCriteria::FrameRange*>([framesPtr pointerValue]));
+  
+  if (!EggSeedSearcher::WriteSeedCache(frames->min, frames->max,
+                                       ProgressHandler(searcherController)))
+    return;
+  
+  // later launches use the new cache too
+  NSUserDefaults  *defaults = [NSUserDefaults standardUserDefaults];
+  [defaults setInteger: frames->min forKey: @"eggSeedCacheFirstFrame"];
+  [defaults setInteger: frames->max forKey: @"eggSeedCacheLastFrame"];
+  
+  EggSeedSearcher::SetCacheFrames(frames->min, frames->max);
+  
+  @synchronized (self)
+  {
+    if (seedCacheIsLoaded)
+    {
+      EggSeedSearcher::ReleaseSeedCache();
+      seedCacheIsLoaded = NO;
+    }
+    
+    [self loadSeedFile];
+  }
+}
+
 - (void)doSearchWithCriteria:(NSValue*)criteriaPtr
 {
   std::auto_ptr<EggSeedSearcher::Criteria> 
@@ -588,8 +664,7 @@ struct ProgressHandler
   
   EggSeedSearcher  searcher;
   
-  searcher.Search(*criteria,
-                  ResultHandler(searcherController, *criteria),
+  searcher.Search(*criteria, ResultHandler(searcherController, *criteria),
                   ProgressHandler(searcherController));
 }
 
@@ -343,7 +343,9 @@ struct ProgressHandler
   
   Gen4EggIVSeedSearcher  searcher;
   
-  searcher.Search(*criteria, ResultHandler(searcherController, *criteria),
+  searcher.Search(*criteria,
+                  ForEachResult<Gen4EggIVSeedSearcher::ResultType>
+                    (ResultHandler(searcherController, *criteria)),
                   ProgressHandler(searcherController));
 }
 
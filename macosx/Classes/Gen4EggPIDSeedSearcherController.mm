@@ -301,7 +301,9 @@ struct ProgressHandler
   
   Gen4EggPIDSeedSearcher  searcher;
   
-  searcher.Search(*criteria, ResultHandler(searcherController, *criteria),
+  searcher.Search(*criteria,
+                  ForEachResult<Gen4EggPIDSeedSearcher::ResultType>
+                    (ResultHandler(searcherController, *criteria)),
                   ProgressHandler(searcherController));
 }
 
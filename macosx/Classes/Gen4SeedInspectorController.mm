@@ -24,6 +24,7 @@
 
 #include "LinearCongruentialRNG.h"
 #include "TimeSeed.h"
+#include "AdjacentSeedGenerator.h"
 #include "FrameGenerator.h"
 #include "Utilities.h"
 
@@ -208,25 +209,33 @@ NSString* GetFrameTypeResult(const Gen4Frame::EncounterData::Frames &frames,
 }
 
 static
-void AddESVRows
-  (NSMutableArray *dest,
-   const std::map<ESV::Value, Gen4Frame::EncounterData::Frames> &esvs)
+void AddESVRows(NSMutableArray *dest, const Gen4Frame::EncounterData &data)
 {
-  std::map<ESV::Value, Gen4Frame::EncounterData::Frames>::const_iterator  i;
+  uint32_t  type, slot;
   
-  for (i = esvs.begin(); i != esvs.end(); ++i)
+  for (type = 0; type < Gen4Frame::EncounterData::NumESVTypes; ++type)
   {
-    [dest addObject:
-      [NSMutableDictionary dictionaryWithObjectsAndKeys:
-        [NSString stringWithFormat: @"%s", ESV::ToString(i->first).c_str()],
-          @"slotName",
-        GetFrameTypeResult(i->second, Gen4Frame::EncounterData::NoSync),
-          @"noSyncFrame",
-        GetFrameTypeResult(i->second, Gen4Frame::EncounterData::Sync),
-          @"syncFrame",
-        GetFrameTypeResult(i->second, Gen4Frame::EncounterData::FailedSync),
-          @"failedSyncFrame",
-        nil]];
+    for (slot = 0; slot < Gen4Frame::EncounterData::NumESVSlots; ++slot)
+    {
+      ESV::Value  esv = ESV::MakeESV(ESV::Type(type << 8), slot);
+      
+      if (!data.HasESV(esv))
+        continue;
+      
+      const Gen4Frame::EncounterData::Frames  &frames = data.ESVFrames(esv);
+      
+      [dest addObject:
+        [NSMutableDictionary dictionaryWithObjectsAndKeys:
+          [NSString stringWithFormat: @"%s", ESV::ToString(esv).c_str()],
+            @"slotName",
+          GetFrameTypeResult(frames, Gen4Frame::EncounterData::NoSync),
+            @"noSyncFrame",
+          GetFrameTypeResult(frames, Gen4Frame::EncounterData::Sync),
+            @"syncFrame",
+          GetFrameTypeResult(frames, Gen4Frame::EncounterData::FailedSync),
+            @"failedSyncFrame",
+          nil]];
+    }
   }
 }
 
@@ -674,13 +683,11 @@ OptionalIVs GetEggIVs(const Gen4BreedingFrame &frame,
   
   Gen4Frame  gen4Frame(targetFrame);
 
-  dpptESVs =
-    [NSMutableArray arrayWithCapacity: gen4Frame.methodJ.esvFrames.size()];
-  AddESVRows(dpptESVs, gen4Frame.methodJ.esvFrames);
+  dpptESVs = [NSMutableArray array];
+  AddESVRows(dpptESVs, gen4Frame.GetMethodJData());
   
-  hgssESVs =
-    [NSMutableArray arrayWithCapacity: gen4Frame.methodK.esvFrames.size()];
-  AddESVRows(hgssESVs, gen4Frame.methodK.esvFrames);
+  hgssESVs = [NSMutableArray array];
+  AddESVRows(hgssESVs, gen4Frame.GetMethodKData());
   
   [esvContentArray setContent: (mode == 0) ? dpptESVs : hgssESVs];
 }
@@ -749,64 +756,40 @@ OptionalIVs GetEggIVs(const Gen4BreedingFrame &frame,
   
   [adjacentsContentArray setContent: [NSMutableArray array]];
   
-  uint16_t  targetDelay = seedTime.delay;
-  uint16_t  delayStep = matchSeedDelayParity ? 2 : 1;
-  uint16_t  endDelay = targetDelay + delayVariance;
-  uint16_t  startDelay = (targetDelay < delayVariance) ? 0 :
-                           targetDelay - delayVariance;
-  if (matchSeedDelayParity && ((startDelay & 0x1) != (targetDelay & 0x1)))
-    ++startDelay;
-  
-  ptime  targetTime(UInt32DateAndTimeToBoostTime(seedTime.date, seedTime.time));
+  Gen4AdjacentSeedGenerator::Criteria  criteria;
   
-  ptime  endTime = targetTime + seconds(secondVariance);
-  targetTime = targetTime - seconds(secondVariance);
+  criteria.targetTime =
+    UInt32DateAndTimeToBoostTime(seedTime.date, seedTime.time);
+  criteria.targetDelay = seedTime.delay;
+  criteria.secondsVariance = secondVariance;
+  criteria.delayVariance = delayVariance;
+  criteria.matchDelayParity = matchSeedDelayParity;
+  criteria.raikouLocation = raikouLocation;
+  criteria.enteiLocation = enteiLocation;
+  criteria.latiLocation = latiLocation;
   
-  int32_t  rLocation = raikouLocation;
-  int32_t  eLocation = enteiLocation;
-  int32_t  lLocation = latiLocation;
+  Gen4AdjacentSeedGenerator::Results  adjacents =
+    Gen4AdjacentSeedGenerator::Generate(criteria);
   
   NSMutableArray  *rowArray =
-    [NSMutableArray arrayWithCapacity:
-      ((2 * delayVariance) + 1) * ((2 * secondVariance) + 1)];
+    [NSMutableArray arrayWithCapacity: adjacents.size()];
   
-  for (; targetTime <= endTime; targetTime = targetTime + seconds(1))
+  Gen4AdjacentSeedGenerator::Results::const_iterator  i;
+  for (i = adjacents.begin(); i != adjacents.end(); ++i)
   {
-    uint32_t  dt = MakeUInt32Date(targetTime.date());
-    uint32_t  yr = GetUInt32DateYear(dt);
-    uint32_t  mo = GetUInt32DateMonth(dt);
-    uint32_t  dy = GetUInt32DateDay(dt);
+    Gen4AdjacentResult  *result = [[Gen4AdjacentResult alloc] init];
     
-    uint32_t  tm = MakeUInt32Time(targetTime.time_of_day());
-    uint32_t  hr = GetUInt32TimeHour(tm);
-    uint32_t  mi = GetUInt32TimeMinute(tm);
-    uint32_t  sc = GetUInt32TimeSecond(tm);
+    result.seed = i->seed.m_seed;
+    result.date = MakeUInt32Date(i->time.date());
+    result.time = MakeUInt32Time(i->time.time_of_day());
+    result.delay = i->delay;
+    result.coinFlips = i->coinFlips.word;
+    result.profElmResponses = i->profElmResponses.word;
+    result.raikou = i->roamers.Location(HGSSRoamers::RAIKOU);
+    result.entei = i->roamers.Location(HGSSRoamers::ENTEI);
+    result.lati = i->roamers.Location(HGSSRoamers::LATI);
     
-    for (uint32_t delay = startDelay; delay <= endDelay; delay += delayStep)
-    {
-      TimeSeed     s(yr, mo, dy, hr, mi, sc, delay);
-      
-      HGSSRoamers  roamers(s.m_seed, rLocation, eLocation, lLocation);
-      LCRNG34      rng(s.m_seed);
-      uint32_t     skipped = roamers.ConsumedFrames();
-      
-      while (skipped-- > 0)
-        rng.Next();
-      
-      Gen4AdjacentResult  *result = [[Gen4AdjacentResult alloc] init];
-      
-      result.seed = s.m_seed;
-      result.date = dt;
-      result.time = tm;
-      result.delay = delay;
-      result.coinFlips = CoinFlips(s.m_seed, 10).word;
-      result.profElmResponses = ProfElmResponses(rng.Seed(), 10).word;
-      result.raikou = roamers.Location(HGSSRoamers::RAIKOU);
-      result.entei = roamers.Location(HGSSRoamers::ENTEI);
-      result.lati = roamers.Location(HGSSRoamers::LATI);
-      
-      [rowArray addObject: result];
-    }
+    [rowArray addObject: result];
   }
   
   [adjacentsContentArray addObjects: rowArray];
@@ -96,17 +96,23 @@ struct ResultHandler
         [NSNumber numberWithUnsignedInt: frame.ivs.HiddenPower()],
           @"hiddenPower",
 				[NSNumber numberWithUnsignedInt: frame.number], @"frame",
-        GetFrameTypeResult(frame.methodJ, Gen4Frame::EncounterData::NoSync),
+        GetFrameTypeResult(frame.GetMethodJESVs(),
+                           Gen4Frame::EncounterData::NoSync),
           @"frameJ",
-        GetFrameTypeResult(frame.methodJ, Gen4Frame::EncounterData::Sync),
+        GetFrameTypeResult(frame.GetMethodJESVs(),
+                           Gen4Frame::EncounterData::Sync),
           @"frameJSync",
-        GetFrameTypeResult(frame.methodJ, Gen4Frame::EncounterData::FailedSync),
+        GetFrameTypeResult(frame.GetMethodJESVs(),
+                           Gen4Frame::EncounterData::FailedSync),
           @"frameJSyncFail",
-        GetFrameTypeResult(frame.methodK, Gen4Frame::EncounterData::NoSync),
+        GetFrameTypeResult(frame.GetMethodKESVs(),
+                           Gen4Frame::EncounterData::NoSync),
           @"frameK",
-        GetFrameTypeResult(frame.methodK, Gen4Frame::EncounterData::Sync),
+        GetFrameTypeResult(frame.GetMethodKESVs(),
+                           Gen4Frame::EncounterData::Sync),
           @"frameKSync",
-        GetFrameTypeResult(frame.methodK, Gen4Frame::EncounterData::FailedSync),
+        GetFrameTypeResult(frame.GetMethodKESVs(),
+                           Gen4Frame::EncounterData::FailedSync),
           @"frameKSyncFail",
         nil];
     
@@ -377,8 +383,9 @@ struct ProgressHandler
   Gen4QuickSeedSearcher  searcher;
   
   searcher.Search(*criteria,
-                  ResultHandler(searcherController,
-                                criteria->tid, criteria->sid),
+                  ForEachResult<Gen4QuickSeedSearcher::ResultType>
+                    (ResultHandler(searcherController,
+                                   criteria->tid, criteria->sid)),
                   ProgressHandler(searcherController));
 }
 
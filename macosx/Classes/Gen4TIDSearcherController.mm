@@ -328,7 +328,8 @@ struct FoundIDSeedSearchProgressHandler
   Gen4TIDSearcher  searcher;
   
   searcher.Search(*criteria,
-                  TIDSearchResultHandler(tidSidSearcherController),
+                  ForEachResult<Gen4TIDSearcher::ResultType>
+                    (TIDSearchResultHandler(tidSidSearcherController)),
                   TIDSearchProgressHandler(tidSidSearcherController));
 }
 
@@ -23,6 +23,7 @@
 #import "StandardSeedInspectorController.h"
 
 #include "HashedSeed.h"
+#include "AdjacentSeedGenerator.h"
 #include "FrameGenerator.h"
 #include "SearchResultProtocols.h"
 #include "Utilities.h"
@@ -185,22 +186,6 @@ SYNTHESIZE_PID_RESULT_PROPERTIES();
   
   [adjacentsContentArray setContent: [NSMutableArray array]];
   
-  uint32_t  timer0Low = targetSeedParams.timer0 - timer0Variance;
-  uint32_t  timer0High = targetSeedParams.timer0 + timer0Variance;
-  
-  if (targetSeedParams.timer0 < timer0Variance)
-    timer0Low = 0;
-  
-  if (targetSeedParams.timer0 > (0xffffffff - timer0Variance))
-    timer0High = 0xffffffff;
-  
-  ptime     seedTime(targetSeedParams.date, hours(targetSeedParams.hour) +
-                                            minutes(targetSeedParams.minute) +
-                                            seconds(targetSeedParams.second));
-  ptime     dt = seedTime;
-  ptime     endTime = dt + seconds(secondsVariance);
-  dt = dt - seconds(secondsVariance);
-  
   uint32_t  pidFrameOffset = matchOffsetFromInitialPIDFrame ?
     (pidFrame -
      targetSeed.GetSkippedPIDFrames(inspectorController.memoryLinkUsed) - 1) :
@@ -209,9 +194,18 @@ SYNTHESIZE_PID_RESULT_PROPERTIES();
   if (pidFrameOffset > pidFrame)
     pidFrameOffset = pidFrame;
   
-  HashedSeed::Parameters  seedParams = targetSeedParams;
+  HashedAdjacentSeedGenerator::Criteria  criteria;
   
-  Gen5PIDFrameGenerator::Parameters  pidFrameParams;
+  criteria.targetSeed = targetSeedParams;
+  criteria.secondsVariance = secondsVariance;
+  criteria.timer0Variance = timer0Variance;
+  
+  criteria.ivFrame = SearchCriteria::FrameRange(ivFrame, ivFrame);
+  criteria.ivFrameType = isRoamer ? HashedIVFrameGenerator::Roamer :
+                                    HashedIVFrameGenerator::Normal;
+  
+  Gen5PIDFrameGenerator::Parameters  &pidFrameParams =
+    criteria.pidFrameParameters;
   pidFrameParams.frameType = encounterFrameType;
   pidFrameParams.leadAbility = encounterLeadAbility;
   pidFrameParams.targetGender = targetGender;
@@ -229,104 +223,65 @@ SYNTHESIZE_PID_RESULT_PROPERTIES();
   
   pidFrameParams.startFromLowestFrame = matchOffsetFromInitialPIDFrame;
   
+  // when matching the offset, frames are counted from each seed's first
+  // usable frame
+  uint32_t  adjacentPIDFrameNum = matchOffsetFromInitialPIDFrame ?
+    (pidFrameOffset + 1) : pidFrame;
+  uint32_t  firstPIDFrameNum = matchOffsetFromInitialPIDFrame ?
+    pidFrameOffset : adjacentPIDFrameNum;
+  
+  criteria.pidFrame.min = (firstPIDFrameNum < (pidFrameVariance + 1)) ?
+    1 : (firstPIDFrameNum - pidFrameVariance);
+  criteria.pidFrame.max = adjacentPIDFrameNum + pidFrameVariance;
+  
+  HashedAdjacentSeedGenerator::Results  adjacents =
+    HashedAdjacentSeedGenerator::Generate(criteria);
+  
   NSMutableArray  *rowArray =
     [NSMutableArray arrayWithCapacity:
-      (timer0High - timer0Low + 1) * ((2 * secondsVariance) + 1)];
+      adjacents.size() * ((2 * pidFrameVariance) + 1)];
   
-  for (; dt <= endTime; dt = dt + seconds(1))
+  HashedAdjacentSeedGenerator::Results::const_iterator  i;
+  for (i = adjacents.begin(); i != adjacents.end(); ++i)
   {
-    seedParams.date = dt.date();
-    
-    time_duration  t = dt.time_of_day();
+    const HashedSeed  &seed = i->seed;
+    IVs               ivs = i->ivs.empty() ? IVs() : i->ivs.front();
     
-    seedParams.hour = t.hours();
-    seedParams.minute = t.minutes();
-    seedParams.second = t.seconds();
+    CGearFrameTime  cgearTime(cgearStartOffset);
     
-    for (uint32_t timer0 = timer0Low; timer0 <= timer0High; ++timer0)
+    std::vector<Gen5PIDFrame>::const_iterator  f;
+    for (f = i->pidFrames.begin(); f != i->pidFrames.end(); ++f)
     {
-      seedParams.timer0 = timer0;
-      
-      HashedSeed  seed(seedParams);
-      
-      HashedIVFrameGenerator  ivGenerator(seed,
-                                          (isRoamer ?
-                                           HashedIVFrameGenerator::Roamer :
-                                           HashedIVFrameGenerator::Normal));
-      
-      for (uint32_t j = 0; j < ivFrame; ++j)
-        ivGenerator.AdvanceFrame();
+      const Gen5PIDFrame  &frame = *f;
       
-      IVs  ivs = ivGenerator.CurrentFrame().ivs;
+      cgearTime.AdvanceFrame(frame.rngValue);
       
-      uint32_t  adjacentPIDFrameNum = matchOffsetFromInitialPIDFrame ?
-        (seed.GetSkippedPIDFrames(inspectorController.memoryLinkUsed) + 1 +
-         pidFrameOffset) :
-        pidFrame;
+      HashedSeedInspectorAdjacentFrame  *result =
+        [[HashedSeedInspectorAdjacentFrame alloc] init];
       
-      uint32_t  skippedFrames;
-      if (matchOffsetFromInitialPIDFrame)
-      {
-        if (pidFrameOffset < (pidFrameVariance + 1))
-          skippedFrames = 0;
-        else
-          skippedFrames = pidFrameOffset - pidFrameVariance - 1;
-      }
-      else
-      {
-        if (adjacentPIDFrameNum < (pidFrameVariance + 1))
-          skippedFrames = 0;
-        else
-          skippedFrames = adjacentPIDFrameNum - pidFrameVariance - 1;
-      }
+      SetHashedSeedResultParameters(result, seed);
       
-      uint32_t  pidEndFrameNum = adjacentPIDFrameNum + pidFrameVariance;
+      SetIVResult(result, ivs, isRoamer);
       
-      Gen5PIDFrameGenerator  pidGenerator(seed, pidFrameParams);
+      result.startFrame = i->skippedPIDFrames + 1;
+      result.pidFrame = frame.number;
       
-      for (uint32_t j = 0; j < skippedFrames; ++j)
-        pidGenerator.AdvanceFrame();
+      SetPIDResult(result, frame.pid, pidFrameParams.tid, pidFrameParams.sid,
+        frame.nature, frame.pid.Gen5Ability(),
+        pidFrameParams.targetGender,
+        ((pidFrameParams.leadAbility == EncounterLead::CUTE_CHARM) &&
+         (pidFrameParams.frameType != Gen5PIDFrameGenerator::EntraLinkFrame))?
+           (frame.abilityActivated ? pidFrameParams.targetRatio :
+                                     Gender::ANY_RATIO) :
+           pidFrameParams.targetRatio);
       
-      CGearFrameTime  cgearTime(cgearStartOffset);
+      result.esv = frame.esv;
+      result.heldItem = frame.heldItem;
+      result.characteristic = Characteristic::Get(frame.pid, ivs);
+      result.details = GetGen5PIDFrameDetails(frame, pidFrameParams,
+                                              cgearTime.GetTicks());
       
-      for (uint32_t f = pidGenerator.CurrentFrame().number;
-           f < pidEndFrameNum;
-           ++f)
-      {
-        pidGenerator.AdvanceFrame();
-        
-        Gen5PIDFrame  frame = pidGenerator.CurrentFrame();
-        
-        cgearTime.AdvanceFrame(frame.rngValue);
-        
-        HashedSeedInspectorAdjacentFrame  *result =
-          [[HashedSeedInspectorAdjacentFrame alloc] init];
-        
-        SetHashedSeedResultParameters(result, seed);
-        
-        SetIVResult(result, ivs, isRoamer);
-        
-        result.startFrame =
-          seed.GetSkippedPIDFrames(inspectorController.memoryLinkUsed) + 1;
-        result.pidFrame = frame.number;
-        
-        SetPIDResult(result, frame.pid, pidFrameParams.tid, pidFrameParams.sid,
-          frame.nature, frame.pid.Gen5Ability(),
-          pidFrameParams.targetGender,
-          ((pidFrameParams.leadAbility == EncounterLead::CUTE_CHARM) &&
-           (pidFrameParams.frameType != Gen5PIDFrameGenerator::EntraLinkFrame))?
-             (frame.abilityActivated ? pidFrameParams.targetRatio :
-                                       Gender::ANY_RATIO) :
-             pidFrameParams.targetRatio);
-        
-        result.esv = frame.esv;
-        result.heldItem = frame.heldItem;
-        result.characteristic = Characteristic::Get(frame.pid, ivs);
-        result.details = GetGen5PIDFrameDetails(frame, pidFrameParams,
-                                                cgearTime.GetTicks());
-        
-        [rowArray addObject: result];
-      }
+      [rowArray addObject: result];
     }
   }
   
@@ -23,6 +23,8 @@
 #import "SearcherController.h"
 #import "IVParameterController.h"
 #import "Gen5ConfigurationController.h"
+#include "HashedSeedSearcher.h"
+#include <boost/scoped_ptr.hpp>
 
 
 @interface HashedSeedSearcherController : NSWindowController
@@ -51,6 +53,8 @@
   
   BOOL      startFromInitialPIDFrame;
   uint32_t  minPIDFrame, maxPIDFrame;
+  
+  boost::scoped_ptr<pprng::IncrementalHashedSeedSearcher>  searcher;
 }
 
 @property (copy) NSDate  *fromDate, *toDate;
@@ -67,5 +71,6 @@
 @property uint32_t  minPIDFrame, maxPIDFrame;
 
 - (IBAction)toggleDropDownChoice:(id)sender;
+- (IBAction)writeSeedTable:(id)sender;
 
 @end
@@ -22,6 +22,7 @@
 #import "HashedSeedSearcherController.h"
 
 #include "HashedSeedSearcher.h"
+#include "HashedSeedTable.h"
 #include "FrameGenerator.h"
 #include "SearchResultProtocols.h"
 #include "Utilities.h"
@@ -394,6 +395,7 @@ struct ResultHandler
   
   bool SearchEncounters
     (const HashedSeed &seed,
+     const HashedSeed::SkippedPIDFrames &skippedFrames,
      const Gen5PIDFrameGenerator::Parameters &frameParameters,
      uint32_t frameTypesMask,
      HashedSeedSearchResult *ivResult)
@@ -406,7 +408,7 @@ struct ResultHandler
       if ((frameTypesMask & (0x1 << f)) != 0)
       {
         parameters.frameType = Gen5PIDFrameGenerator::FrameType(f);
-        Gen5PIDFrameGenerator  generator(seed, parameters);
+        Gen5PIDFrameGenerator  generator(seed, skippedFrames, parameters);
         
         uint32_t  minFrame = m_criteria.pid.startFromLowestFrame ?
                                0 : m_criteria.pidFrame.min - 1;
@@ -495,6 +497,7 @@ struct ResultHandler
   }
   
   bool SearchHiddenHollowFrame(const HashedSeed &seed,
+     const HashedSeed::SkippedPIDFrames &skippedFrames,
      const Gen5PIDFrameGenerator::Parameters &baseParameters,
      HashedSeedSearchResult *ivResult)
   {
@@ -505,14 +508,32 @@ struct ResultHandler
         ((m_criteria.pid.genderRatio != Gender::ANY_RATIO) ||
          (m_criteria.pid.gender == Gender::GENDERLESS)))
     {
-      shinyFound = SearchEncounters(seed, frameParameters,
+      shinyFound = SearchEncounters(seed, skippedFrames, frameParameters,
                                     HiddenHollowFrameType, ivResult);
     }
     
     return shinyFound;
   }
   
-  void operator()(const HashedIVFrame &frame)
+  void operator()(const HashedIVFrame *frames, std::size_t numFrames)
+  {
+    std::vector<uint64_t>                      rawSeeds(numFrames);
+    std::vector<HashedSeed::SkippedPIDFrames>  skippedFrames(numFrames);
+    
+    for (std::size_t i = 0; i < numFrames; ++i)
+      rawSeeds[i] = frames[i].seed.rawSeed;
+    
+    HashedSeed::CalculateSkippedPIDFrames(&rawSeeds[0], numFrames,
+                                          m_criteria.seedParameters.version,
+                                          m_criteria.memoryLinkUsed,
+                                          &skippedFrames[0]);
+    
+    for (std::size_t i = 0; i < numFrames; ++i)
+      AddFrame(frames[i], skippedFrames[i]);
+  }
+  
+  void AddFrame(const HashedIVFrame &frame,
+                const HashedSeed::SkippedPIDFrames &skippedFrames)
   {
     HashedSeedSearchResult  *result = [[HashedSeedSearchResult alloc] init];
     
@@ -521,8 +542,7 @@ struct ResultHandler
     result.ivFrame = frame.number;
     SetIVResult(result, frame.ivs, m_criteria.ivs.isRoamer);
     
-    result.pidStartFrame =
-      frame.seed.GetSkippedPIDFrames(m_criteria.memoryLinkUsed) + 1;
+    result.pidStartFrame = skippedFrames.count + 1;
     
     bool  shinyFound = false;
     
@@ -543,20 +563,22 @@ struct ResultHandler
     if (CheckBitMask(m_criteria.leadAbilityMask, EncounterLead::OTHER))
     {
       frameParameters.leadAbility = EncounterLead::OTHER;
-      shinyFound = SearchEncounters(frame.seed, frameParameters,
+      shinyFound = SearchEncounters(frame.seed, skippedFrames, frameParameters,
                                     OtherFrameTypes, result);
       shinyFound =
-        SearchHiddenHollowFrame(frame.seed, frameParameters, result) ||
+        SearchHiddenHollowFrame(frame.seed, skippedFrames,
+                                frameParameters, result) ||
           shinyFound;
     }
     
     if (CheckBitMask(m_criteria.leadAbilityMask, EncounterLead::SYNCHRONIZE))
     {
       frameParameters.leadAbility = EncounterLead::SYNCHRONIZE;
-      shinyFound = SearchEncounters(frame.seed, frameParameters,
+      shinyFound = SearchEncounters(frame.seed, skippedFrames, frameParameters,
                                     SyncFrameTypes, result) || shinyFound;
       shinyFound =
-        SearchHiddenHollowFrame(frame.seed, frameParameters, result) ||
+        SearchHiddenHollowFrame(frame.seed, skippedFrames,
+                                frameParameters, result) ||
           shinyFound;
     }
     
@@ -564,7 +586,7 @@ struct ResultHandler
     {
       frameParameters.leadAbility = EncounterLead::COMPOUND_EYES;
       shinyFound =
-        SearchEncounters(frame.seed, frameParameters,
+        SearchEncounters(frame.seed, skippedFrames, frameParameters,
                          CompoundEyesFrameTypes, result) || shinyFound;
     }
     
@@ -572,7 +594,7 @@ struct ResultHandler
     {
       frameParameters.leadAbility = EncounterLead::SUCTION_CUPS;
       shinyFound =
-        SearchEncounters(frame.seed, frameParameters,
+        SearchEncounters(frame.seed, skippedFrames, frameParameters,
                          SuctionCupsFrameTypes, result) || shinyFound;
     }
     
@@ -586,7 +608,7 @@ struct ResultHandler
         if (m_criteria.pid.gender != Gender::ANY)
         {
           shinyFound =
-            SearchEncounters(frame.seed, frameParameters,
+            SearchEncounters(frame.seed, skippedFrames, frameParameters,
                              CuteCharmFrameTypes, result) || shinyFound;
         }
         else
@@ -595,7 +617,7 @@ struct ResultHandler
           {
             frameParameters.targetGender = Gender::Type(t);
             shinyFound =
-              SearchEncounters(frame.seed, frameParameters,
+              SearchEncounters(frame.seed, skippedFrames, frameParameters,
                                CuteCharmFrameTypes, result) || shinyFound;
           }
         }
@@ -612,7 +634,7 @@ struct ResultHandler
             frameParameters.targetRatio = Gender::Ratio(r);
             
             shinyFound =
-              SearchEncounters(frame.seed, frameParameters,
+              SearchEncounters(frame.seed, skippedFrames, frameParameters,
                                CuteCharmFrameTypes, result) || shinyFound;
           }
         }
@@ -652,6 +674,9 @@ struct ProgressHandler
 }
 
 
+// 8 bytes per seed
+static const uint64_t  MaxSeedTableSeeds = 0x10000000ULL;
+
 @implementation HashedSeedSearcherController
 
 @synthesize fromDate, toDate;
@@ -691,6 +716,9 @@ struct ProgressHandler
   self.minIVFrame = 1;
   self.maxIVFrame = 1;
   
+  // keeps the last search's results, for refining it
+  searcher.reset(new IncrementalHashedSeedSearcher());
+  
   self.showShinyOnly = NO;
   self.ability = Ability::ANY;
   self.gender = Gender::ANY;
@@ -921,67 +949,76 @@ struct ProgressHandler
   }
 }
 
-// dummy method for error panel
-- (void)alertDidEnd:(NSAlert *)alert returnCode:(NSInteger)returnCode
-        contextInfo:(void *)contextInfo
-{}
-
-- (NSValue*)getValidatedSearchCriteria
+- (HashedSeedGenerator::Parameters)seedParameters
 {
   using namespace boost::gregorian;
   using namespace boost::posix_time;
   
-  if (!EndEditing([self window]))
-    return nil;
-  
-  GUICriteria  criteria;
+  HashedSeedGenerator::Parameters  parameters;
   
-  criteria.seedParameters.macAddress = [gen5ConfigController macAddress];
+  parameters.macAddress = [gen5ConfigController macAddress];
   
-  criteria.seedParameters.version = [gen5ConfigController version];
-  criteria.seedParameters.dsType = [gen5ConfigController dsType];
+  parameters.version = [gen5ConfigController version];
+  parameters.dsType = [gen5ConfigController dsType];
   
-  criteria.seedParameters.timer0Low = [gen5ConfigController timer0Low];
-  criteria.seedParameters.timer0High = [gen5ConfigController timer0High];
+  parameters.timer0Low = [gen5ConfigController timer0Low];
+  parameters.timer0High = [gen5ConfigController timer0High];
   
-  criteria.seedParameters.vcountLow = [gen5ConfigController vcountLow];
-  criteria.seedParameters.vcountHigh = [gen5ConfigController vcountHigh];
+  parameters.vcountLow = [gen5ConfigController vcountLow];
+  parameters.vcountHigh = [gen5ConfigController vcountHigh];
   
-  criteria.seedParameters.vframeLow = [gen5ConfigController vframeLow];
-  criteria.seedParameters.vframeHigh = [gen5ConfigController vframeHigh];
+  parameters.vframeLow = [gen5ConfigController vframeLow];
+  parameters.vframeHigh = [gen5ConfigController vframeHigh];
   
   if (noButtonHeld)
   {
-    criteria.seedParameters.heldButtons.push_back(0);  // no keys
+    parameters.heldButtons.push_back(0);  // no keys
   }
   if (oneButtonHeld)
   {
-    criteria.seedParameters.heldButtons.insert
-      (criteria.seedParameters.heldButtons.end(),
+    parameters.heldButtons.insert
+      (parameters.heldButtons.end(),
        Button::SingleButtons().begin(),
        Button::SingleButtons().end());
   }
   if (twoButtonsHeld)
   {
-    criteria.seedParameters.heldButtons.insert
-      (criteria.seedParameters.heldButtons.end(),
+    parameters.heldButtons.insert
+      (parameters.heldButtons.end(),
        Button::TwoButtonCombos().begin(),
        Button::TwoButtonCombos().end());
   }
   if (threeButtonsHeld)
   {
-    criteria.seedParameters.heldButtons.insert
-      (criteria.seedParameters.heldButtons.end(),
+    parameters.heldButtons.insert
+      (parameters.heldButtons.end(),
        Button::ThreeButtonCombos().begin(),
        Button::ThreeButtonCombos().end());
   }
   
-  criteria.seedParameters.fromTime =
+  parameters.fromTime =
     ptime(NSDateToBoostDate(fromDate), seconds(0));
   
-  criteria.seedParameters.toTime =
+  parameters.toTime =
     ptime(NSDateToBoostDate(toDate), hours(23) + minutes(59) + seconds(59));
   
+  return parameters;
+}
+
+// dummy method for error panel
+- (void)alertDidEnd:(NSAlert *)alert returnCode:(NSInteger)returnCode
+        contextInfo:(void *)contextInfo
+{}
+
+- (NSValue*)getValidatedSearchCriteria
+{
+  if (!EndEditing([self window]))
+    return nil;
+  
+  GUICriteria  criteria;
+  
+  criteria.seedParameters = [self seedParameters];
+  
   criteria.ivFrame.min = minIVFrame;
   criteria.ivFrame.max = maxIVFrame;
   
@@ -1030,15 +1067,56 @@ struct ProgressHandler
   }
 }
 
+// sent through the responder chain by the File menu's Write Seed Table item
+- (IBAction)writeSeedTable:(id)sender
+{
+  if ([searcherController isSearching] || !EndEditing([self window]))
+    return;
+  
+  HashedSeedGenerator::Parameters  parameters = [self seedParameters];
+  
+  if (parameters.NumberOfSeeds() > MaxSeedTableSeeds)
+  {
+    NSAlert *alert = [[NSAlert alloc] init];
+    
+    [alert addButtonWithTitle:@"OK"];
+    [alert setMessageText: @"Please Limit Seed Table Parameters"];
+    [alert setInformativeText: @"A seed table for the current profile and search parameters would be larger than 2 GB. Please limit the date range, use fewer held keys, or narrow the Timer0, VCount or VFrame ranges."];
+    [alert setAlertStyle:NSWarningAlertStyle];
+    
+    [alert beginSheetModalForWindow: [self window] modalDelegate: self
+           didEndSelector: @selector(alertDidEnd:returnCode:contextInfo:)
+           contextInfo: nil];
+    return;
+  }
+  
+  [searcherController
+    startBackgroundTask: @selector(doWriteSeedTableWithParameters:)
+    withObject: [NSValue valueWithPointer:
+                  new HashedSeedGenerator::Parameters(parameters)]];
+}
+
+- (void)doWriteSeedTableWithParameters:(NSValue*)parametersPtr
+{
+  std::auto_ptr<HashedSeedGenerator::Parameters>
+    parameters(static_cast<HashedSeedGenerator::Parameters*>
+      ([parametersPtr pointerValue]));
+  
+  std::string  filePath = HashedSeedTable::TableFilePath();
+  
+  // later searches of this profile and times read the table's raw seeds
+  if (HashedSeedTable::Write(*parameters, filePath,
+                             ProgressHandler(searcherController)))
+    HashedSeedTable::Load(filePath);
+}
+
 - (void)doSearchWithCriteria:(NSValue*)criteriaPtr
 {
   std::auto_ptr<GUICriteria> 
     criteria(static_cast<GUICriteria*>([criteriaPtr pointerValue]));
   
-  HashedSeedSearcher  searcher;
-  
-  searcher.Search(*criteria, ResultHandler(searcherController, *criteria),
-                  ProgressHandler(searcherController));
+  searcher->Search(*criteria, ResultHandler(searcherController, *criteria),
+                   ProgressHandler(searcherController));
 }
 
 
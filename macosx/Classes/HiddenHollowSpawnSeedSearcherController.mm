@@ -278,7 +278,8 @@ struct ProgressHandler
   
   searcher.Search
     (*criteria,
-     ResultHandler(searcherController),
+     ForEachResult<HiddenHollowSpawnSeedSearcher::ResultType>
+       (ResultHandler(searcherController)),
      ProgressHandler(searcherController));
 }
 
@@ -34,6 +34,7 @@
   
   SEL                           getValidatedSearchCriteriaSelector;
   SEL                           doSearchWithCriteriaSelector;
+  SEL                           backgroundTaskSelector;
   
   BOOL                          isSearching;
   BOOL                          shouldStopSearch;
@@ -53,4 +54,8 @@
 - (void)adjustProgress:(NSNumber*)progressDelta;
 - (void)addResult:(id)result;
 
+// runs [delegate taskSelector: argument] in the background as a search is
+// run, sharing the progress bar and Stop button, but leaving the results
+- (void)startBackgroundTask:(SEL)taskSelector withObject:(id)argument;
+
 @end
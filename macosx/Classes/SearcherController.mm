@@ -95,6 +95,28 @@
         withObject: nil waitUntilDone: NO];
 }
 
+- (void)runBackgroundTask:(id)argument
+{
+  [delegate performSelector: backgroundTaskSelector withObject: argument];
+  [self setIsSearching: NO];
+  [self performSelectorOnMainThread: @selector(finishSearch)
+        withObject: nil waitUntilDone: NO];
+}
+
+- (void)startBackgroundTask:(SEL)taskSelector withObject:(id)argument
+{
+  if (isSearching)
+    return;
+  
+  backgroundTaskSelector = taskSelector;
+  shouldStopSearch = NO;
+  [self setIsSearching: YES];
+  [self performSelectorInBackground: @selector(runBackgroundTask:)
+        withObject: argument];
+  
+  [startStopButton setTitle: @"Stop"];
+}
+
 - (IBAction)startStop:(id)sender
 {
   if (isSearching)
@@ -567,7 +567,8 @@ struct IDFrameSearchProgressHandler
   TrainerIDSearcher  searcher;
   
   searcher.Search(*criteria,
-                  TrainerIDSearchResultHandler(tidSidSearcherController),
+                  ForEachResult<TrainerIDSearcher::ResultType>
+                    (TrainerIDSearchResultHandler(tidSidSearcherController)),
                   TrainerIDSearchProgressHandler(tidSidSearcherController));
 }
 
@@ -674,7 +675,8 @@ struct IDFrameSearchProgressHandler
   TrainerIDSearcher  searcher;
   
   searcher.Search(*criteria,
-                  IDFrameSearchResultHandler(idFrameSearcherController),
+                  ForEachResult<TrainerIDSearcher::ResultType>
+                    (IDFrameSearchResultHandler(idFrameSearcherController)),
                   IDFrameSearchProgressHandler(idFrameSearcherController));
 }
 
@@ -322,11 +322,14 @@ SYNTHESIZE_IV_RESULT_PROPERTIES();
   ptime  endTime = dt + seconds(secondsVariance);
   dt = dt - seconds(secondsVariance);
   
+  uint32_t  targetSkippedFrames =
+    targetSeed.GetSkippedPIDFrames(memoryLinkUsed);
+  
   bool  useOffset = matchOffsetFromInitialFrame &&
-    (targetFrame > targetSeed.GetSkippedPIDFrames(memoryLinkUsed));
+    (targetFrame > targetSkippedFrames);
   
   uint32_t  frameOffset = useOffset ?
-    (targetFrame - targetSeed.GetSkippedPIDFrames(memoryLinkUsed) - 1) :
+    (targetFrame - targetSkippedFrames - 1) :
     (targetFrame - 1);
   
   HashedSeed::Parameters  seedParams = targetSeedParams;
@@ -362,8 +365,15 @@ SYNTHESIZE_IV_RESULT_PROPERTIES();
       
       HashedSeed  seed(seedParams);
       
+      WonderCardFrameGenerator  generator(seed, frameParams);
+      
+      // a generator starting from the lowest frame has already skipped them
+      uint32_t  seedSkippedFrames = useOffset ?
+        generator.CurrentFrame().number :
+        seed.GetSkippedPIDFrames(memoryLinkUsed);
+      
       uint32_t  adjacentFrameNum = useOffset ?
-        (seed.GetSkippedPIDFrames(memoryLinkUsed) + 1 + frameOffset) :
+        (seedSkippedFrames + 1 + frameOffset) :
         targetFrame;
       
       uint32_t  skippedFrames;
@@ -384,8 +394,6 @@ SYNTHESIZE_IV_RESULT_PROPERTIES();
       
       uint32_t  endFrameNum = adjacentFrameNum + targetFrameVariance;
       
-      WonderCardFrameGenerator  generator(seed, frameParams);
-      
       for (uint32_t j = 0; j < skippedFrames; ++j)
         generator.AdvanceFrame();
       
@@ -401,7 +409,7 @@ SYNTHESIZE_IV_RESULT_PROPERTIES();
         
         SetHashedSeedResultParameters(row, seed);
         
-        row.startFrame = seed.GetSkippedPIDFrames(memoryLinkUsed) + 1;
+        row.startFrame = seedSkippedFrames + 1;
         row.frame = frame.number;
         
         SetPIDResult(row, frame.pid, frameParams.cardTID, frameParams.cardSID,
@@ -88,7 +88,23 @@ struct ResultHandler
       m_cardTID(cardTID), m_cardSID(cardSID)
   {}
   
-  void operator()(const WonderCardFrame &frame)
+  void operator()(const WonderCardFrame *frames, std::size_t numFrames)
+  {
+    std::vector<uint64_t>                      rawSeeds(numFrames);
+    std::vector<HashedSeed::SkippedPIDFrames>  skippedFrames(numFrames);
+    
+    for (std::size_t i = 0; i < numFrames; ++i)
+      rawSeeds[i] = frames[i].seed.rawSeed;
+    
+    HashedSeed::CalculateSkippedPIDFrames
+      (&rawSeeds[0], numFrames, m_criteria.seedParameters.version,
+       m_criteria.frameParameters.memoryLinkUsed, &skippedFrames[0]);
+    
+    for (std::size_t i = 0; i < numFrames; ++i)
+      AddFrame(frames[i], skippedFrames[i].count);
+  }
+  
+  void AddFrame(const WonderCardFrame &frame, uint32_t skippedFrames)
   {
     WonderCardSeedSearchResult  *result =
       [[WonderCardSeedSearchResult alloc] init];
@@ -103,9 +119,7 @@ struct ResultHandler
     
     SetHashedSeedResultParameters(result, frame.seed);
     
-    result.startFrame =
-      frame.seed.GetSkippedPIDFrames
-        (m_criteria.frameParameters.memoryLinkUsed) + 1;
+    result.startFrame = skippedFrames + 1;
     
     result.frame = frame.number;
     